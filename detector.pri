@@ -0,0 +1,13 @@
+SOURCES += \
+    $$PWD/src/detector/spectr_frame.cpp \
+    $$PWD/src/detector/event_detector.cpp
+
+HEADERS += \
+    $$PWD/src/detector/spectr_frame.h \
+    $$PWD/src/detector/event_detector.h
+
+INCLUDEPATH += \
+    $$PWD/src/detector
+
+DEPENDPATH += \
+    $$PWD/src/detector
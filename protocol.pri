@@ -6,7 +6,11 @@ SOURCES += \
     $$PWD/src/protocol/system_monitor.cpp \
     $$PWD/src/protocol/params_spectr.cpp \
     $$PWD/src/protocol/sweep_topic.cpp \
-    $$PWD/src/protocol/broker_ctrl.cpp
+    $$PWD/src/protocol/broker_ctrl.cpp \
+    $$PWD/src/protocol/reader_ctrl.cpp \
+    $$PWD/src/protocol/occupancy_spectr.cpp \
+    $$PWD/src/protocol/spectr_event.cpp \
+    $$PWD/src/protocol/spectr_sparse.cpp
 
 HEADERS += \
     $$PWD/src/protocol/constkeys.h \
@@ -17,7 +21,11 @@ HEADERS += \
     $$PWD/src/protocol/system_monitor.h \
     $$PWD/src/protocol/params_spectr.h \
     $$PWD/src/protocol/sweep_topic.h \
-    $$PWD/src/protocol/broker_ctrl.h
+    $$PWD/src/protocol/broker_ctrl.h \
+    $$PWD/src/protocol/reader_ctrl.h \
+    $$PWD/src/protocol/occupancy_spectr.h \
+    $$PWD/src/protocol/spectr_event.h \
+    $$PWD/src/protocol/spectr_sparse.h
 
 
 INCLUDEPATH += \
@@ -3,6 +3,7 @@ TEMPLATE = subdirs
 SUBDIRS += \
     src/qsweepserver \
     src/qsweepclient \
-    src/qsweepwrite
+    src/qsweepwrite \
+    src/qsweepwrite/benchmark/soak_chunk_rotation
 
 CONFIG += ordered
@@ -0,0 +1,223 @@
+#include "event_detector.h"
+
+#include <QDateTime>
+#include <algorithm>
+
+#include "spectr_frame.h"
+
+// one detection (contiguous bins above threshold)
+struct event_detection
+{
+    quint64 m_hz_low = 0;
+    quint64 m_hz_high = 0;
+    quint64 m_hz_peak = 0;
+    float m_peak = 0;
+    bool m_matched = false;
+};
+
+event_detector::event_detector()
+{
+    // unique between restarts
+    m_next_event_id = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch())*1000;
+}
+
+void event_detector::set_threshold(const float &value)
+{
+    m_threshold = value;
+}
+
+void event_detector::set_min_bins(const int &value)
+{
+    m_min_bins = qMax(1, value);
+}
+
+void event_detector::set_hold(const int &value)
+{
+    m_hold = qMax(0, value);
+}
+
+QVector<spectr_event> event_detector::process(const spectr_frame &frame)
+{
+    QVector<spectr_event> events;
+
+    if(!frame.is_valid())
+        return events;
+
+    const int size = frame.m_power.size();
+    const float *power = frame.m_power.constData();
+
+    // detection level per bin
+    QVector<float> level(size);
+    float floor;
+
+    if(frame.has_noise_floor())
+    {
+        for(int i=0; i<size; ++i)
+            level[i] = frame.m_noise_floor.at(i) + m_threshold;
+
+        floor = noise_floor(frame.m_noise_floor);
+    }else{
+        floor = noise_floor(frame.m_power);
+        level.fill(floor + m_threshold);
+    }
+
+    // bin -> frequency (Hz)
+    auto bin_hz = [&frame](const int &bin) {
+        return frame.m_hz_low + static_cast<quint64>(bin*frame.m_fft_bin_width);
+    };
+
+    QVector<event_detection> detections;
+
+    for(int i=0; i<size; ++i)
+    {
+        if(power[i] <= level.at(i))
+            continue;
+
+        int peak = i;
+        int end = i;
+
+        while((end < size)&&(power[end] > level.at(end)))
+        {
+            if(power[end] > power[peak])
+                peak = end;
+            end++;
+        }
+
+        if(end - i >= m_min_bins)
+        {
+            event_detection detection;
+            detection.m_hz_low = bin_hz(i);
+            detection.m_hz_high = bin_hz(end);
+            detection.m_hz_peak = bin_hz(peak) + static_cast<quint64>(frame.m_fft_bin_width/2);
+            detection.m_peak = power[peak];
+            detections.append(detection);
+        }
+
+        i = end;
+    }
+
+    QList<event_track> &tracks = m_tracks[frame.m_params_id];
+
+    for(int t=0; t<tracks.size(); ++t)
+    {
+        event_track &track = tracks[t];
+        bool is_detected(false);
+
+        for(int d=0; d<detections.size(); ++d)
+        {
+            event_detection &detection = detections[d];
+
+            if((detection.m_hz_low < track.m_hz_high)&&(track.m_hz_low < detection.m_hz_high))
+            {
+                if(!is_detected)
+                {
+                    track.m_hz_low = detection.m_hz_low;
+                    track.m_hz_high = detection.m_hz_high;
+                }else{
+                    track.m_hz_low = qMin(track.m_hz_low, detection.m_hz_low);
+                    track.m_hz_high = qMax(track.m_hz_high, detection.m_hz_high);
+                }
+
+                if(detection.m_peak > track.m_peak)
+                {
+                    track.m_peak = detection.m_peak;
+                    track.m_hz_peak = detection.m_hz_peak;
+                }
+
+                detection.m_matched = true;
+                is_detected = true;
+            }
+        }
+
+        if(is_detected)
+        {
+            track.m_bandwidth = qMax(track.m_bandwidth, track.m_hz_high - track.m_hz_low);
+            track.m_noise_floor = floor;
+            track.m_last = frame.m_time;
+            track.m_missed = 0;
+        }else{
+            track.m_missed++;
+        }
+    }
+
+    // stop
+    for(int t=tracks.size()-1; t>=0; --t)
+    {
+        if(tracks.at(t).m_missed > m_hold)
+        {
+            events.append(to_event(frame.m_params_id, tracks.at(t), event_state::stop));
+            tracks.removeAt(t);
+        }
+    }
+
+    // start
+    for(int d=0; d<detections.size(); ++d)
+    {
+        const event_detection &detection = detections.at(d);
+
+        if(detection.m_matched)
+            continue;
+
+        event_track track;
+        track.m_event_id = m_next_event_id++;
+        track.m_start = frame.m_time;
+        track.m_last = frame.m_time;
+        track.m_hz_low = detection.m_hz_low;
+        track.m_hz_high = detection.m_hz_high;
+        track.m_hz_peak = detection.m_hz_peak;
+        track.m_bandwidth = detection.m_hz_high - detection.m_hz_low;
+        track.m_peak = detection.m_peak;
+        track.m_noise_floor = floor;
+
+        tracks.append(track);
+        events.append(to_event(frame.m_params_id, track, event_state::start));
+    }
+
+    return events;
+}
+
+QVector<spectr_event> event_detector::flush()
+{
+    QVector<spectr_event> events;
+
+    for(auto it = m_tracks.constBegin(); it != m_tracks.constEnd(); ++it)
+        for(int t=0; t<it.value().size(); ++t)
+            events.append(to_event(it.key(), it.value().at(t), event_state::stop));
+
+    m_tracks.clear();
+
+    return events;
+}
+
+float event_detector::noise_floor(const QVector<float> &power)
+{
+    if(power.isEmpty())
+        return 0;
+
+    QVector<float> values(power);
+    const auto middle = values.begin() + values.size()/2;
+
+    std::nth_element(values.begin(), middle, values.end());
+
+    return *middle;
+}
+
+spectr_event event_detector::to_event(const QString &params_id, const event_track &track, const event_state &state)
+{
+    spectr_event event;
+    event.set_id_params(params_id);
+    event.set_event_id(track.m_event_id);
+    event.set_state(state);
+    event.set_dt_start(QDateTime::fromMSecsSinceEpoch(track.m_start, Qt::UTC));
+
+    if(state == event_state::stop)
+        event.set_dt_stop(QDateTime::fromMSecsSinceEpoch(track.m_last, Qt::UTC));
+
+    event.set_hz_center((track.m_hz_low + track.m_hz_high)/2);
+    event.set_hz_peak(track.m_hz_peak);
+    event.set_bandwidth(track.m_bandwidth);
+    event.set_peak_power(static_cast<qreal>(track.m_peak));
+    event.set_noise_floor(static_cast<qreal>(track.m_noise_floor));
+
+    return event;
+}
@@ -0,0 +1,59 @@
+#ifndef EVENT_DETECTOR_H
+#define EVENT_DETECTOR_H
+
+#include <QMap>
+#include <QList>
+#include <QVector>
+
+#include "spectr_event.h"
+
+struct spectr_frame;
+
+// emission tracked across sweeps
+struct event_track
+{
+    quint64 m_event_id = 0;
+    qint64 m_start = 0;         // ms since epoch (UTC)
+    qint64 m_last = 0;
+    quint64 m_hz_low = 0;       // last detection
+    quint64 m_hz_high = 0;
+    quint64 m_hz_peak = 0;      // frequency of max power
+    quint64 m_bandwidth = 0;    // max bandwidth
+    float m_peak = 0;
+    float m_noise_floor = 0;
+    int m_missed = 0;           // sweeps without detection
+};
+
+// noise floor (per bin series of the server, or median of sweep)
+// + threshold, contiguous bins above
+// threshold are one detection, detections are matched to tracks by
+// overlapping frequency range; a track stops after "hold" sweeps
+// without detection. No Qt event loop dependency.
+class event_detector
+{
+public:
+    event_detector();
+
+    void set_threshold(const float &);      // dB above noise floor
+    void set_min_bins(const int &);
+    void set_hold(const int &);
+
+    // start/stop events
+    QVector<spectr_event> process(const spectr_frame &);
+    // stop all tracks
+    QVector<spectr_event> flush();
+
+private:
+    float m_threshold = 10;
+    int m_min_bins = 2;
+    int m_hold = 3;
+    quint64 m_next_event_id = 0;
+
+    // by params_id
+    QMap<QString, QList<event_track> > m_tracks;
+
+    static float noise_floor(const QVector<float> &);
+    static spectr_event to_event(const QString &, const event_track &, const event_state &);
+};
+
+#endif // EVENT_DETECTOR_H
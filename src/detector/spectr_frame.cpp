@@ -0,0 +1,74 @@
+#include "spectr_frame.h"
+
+#include <algorithm>
+
+#include "data_spectr.h"
+
+bool spectr_frame::is_valid() const
+{
+    return !m_power.isEmpty();
+}
+
+bool spectr_frame::has_noise_floor() const
+{
+    return (!m_noise_floor.isEmpty())&&(m_noise_floor.size() == m_power.size());
+}
+
+bool spectr_frame::is_same_layout(const spectr_frame &other) const
+{
+    return (m_hz_low == other.m_hz_low)
+            &&(m_hz_high == other.m_hz_high)
+            &&(m_power.size() == other.m_power.size());
+}
+
+spectr_frame spectr_frame::from_data_spectr(const data_spectr &data)
+{
+    spectr_frame frame;
+    QVector<power_spectr> powers(data.spectr());
+
+    frame.m_params_id = data.id_params();
+
+    if(powers.isEmpty())
+        return frame;
+
+    std::sort(powers.begin(), powers.end(), [](const power_spectr &a, const power_spectr &b) {
+        return a.hz_low < b.hz_low;
+    });
+
+    int bin_count = 0;
+    bool is_noise_floor(true);
+
+    for(int i=0; i<powers.size(); ++i)
+    {
+        bin_count += powers.at(i).m_power.size();
+        is_noise_floor = is_noise_floor&&(powers.at(i).m_noise_floor.size() == powers.at(i).m_power.size());
+    }
+
+    frame.m_power.reserve(bin_count);
+
+    if(is_noise_floor)
+        frame.m_noise_floor.reserve(bin_count);
+
+    for(int i=0; i<powers.size(); ++i)
+    {
+        const QVector<qreal> &power = powers.at(i).m_power;
+
+        for(int w=0; w<power.size(); ++w)
+            frame.m_power.append(static_cast<float>(power.at(w)));
+
+        if(is_noise_floor)
+        {
+            const QVector<qreal> &noise_floor = powers.at(i).m_noise_floor;
+
+            for(int w=0; w<noise_floor.size(); ++w)
+                frame.m_noise_floor.append(static_cast<float>(noise_floor.at(w)));
+        }
+    }
+
+    frame.m_time = powers.first().m_date_time.toMSecsSinceEpoch();
+    frame.m_hz_low = powers.first().hz_low;
+    frame.m_hz_high = powers.last().hz_high;
+    frame.m_fft_bin_width = powers.first().m_fft_bin_width;
+
+    return frame;
+}
@@ -0,0 +1,28 @@
+#ifndef SPECTR_FRAME_H
+#define SPECTR_FRAME_H
+
+#include <QString>
+#include <QVector>
+
+class data_spectr;
+
+// one sweep: segments sorted by frequency and joined into one bin array
+struct spectr_frame
+{
+    QString m_params_id;
+    qint64 m_time = 0;          // ms since epoch (UTC), first segment
+    quint64 m_hz_low = 0;
+    quint64 m_hz_high = 0;
+    qreal m_fft_bin_width = 0;
+    QVector<float> m_power;
+    QVector<float> m_noise_floor;   // empty if not sent by the server
+
+    bool has_noise_floor()const;
+
+    bool is_valid()const;
+    bool is_same_layout(const spectr_frame &)const;
+
+    static spectr_frame from_data_spectr(const data_spectr &);
+};
+
+#endif // SPECTR_FRAME_H
@@ -6,6 +6,9 @@
 static const QString DT_FORMAT = QStringLiteral("hh:mm:ss.zzz dd.MM.yyyy");
 
 static const QString DATA_KEY = QStringLiteral("data");
+// routing of data without parsing "data" (sweep_message::peek_route)
+static const QString ROUTE_ID_KEY = QStringLiteral("route_id");
+static const QString ROUTE_HZ_KEY = QStringLiteral("route_hz");
 static const QString DT_KEY = QStringLiteral("dt");
 
 static const QString BROKER_CTRL_TYPE_KEY = QStringLiteral("broker_ctrl_type");
@@ -35,6 +38,34 @@ static const QString DESCR_KEY = QStringLiteral("descr");
 static const QString POWERS_KEY = QStringLiteral("powers");
 static const QString NUM_SAMPLES_KEY = QStringLiteral("num_samples");
 
+static const QString READER_CTRL_TYPE_KEY = QStringLiteral("reader_ctrl_type");
+static const QString DT_FROM_KEY = QStringLiteral("dt_from");
+static const QString DT_TO_KEY = QStringLiteral("dt_to");
+static const QString LIMIT_KEY = QStringLiteral("limit");
+static const QString FILE_NAME_KEY = QStringLiteral("file_name");
+
+static const QString WINDOW_KEY = QStringLiteral("window");
+static const QString THRESHOLD_KEY = QStringLiteral("threshold");
+static const QString SWEEP_COUNT_KEY = QStringLiteral("sweep_count");
+static const QString OCCUPANCY_KEY = QStringLiteral("occupancy");
+static const QString MEAN_KEY = QStringLiteral("mean");
+static const QString MAX_KEY = QStringLiteral("max");
+static const QString P50_KEY = QStringLiteral("p50");
+static const QString P90_KEY = QStringLiteral("p90");
+
+static const QString EVENT_ID_KEY = QStringLiteral("event_id");
+static const QString EVENT_STATE_KEY = QStringLiteral("event_state");
+static const QString DT_START_KEY = QStringLiteral("dt_start");
+static const QString DT_STOP_KEY = QStringLiteral("dt_stop");
+static const QString FREQUENCY_CENTER_KEY = QStringLiteral("frequency_center");
+static const QString FREQUENCY_PEAK_KEY = QStringLiteral("frequency_peak");
+static const QString BANDWIDTH_KEY = QStringLiteral("bandwidth");
+static const QString PEAK_POWER_KEY = QStringLiteral("peak_power");
+static const QString NOISE_FLOOR_KEY = QStringLiteral("noise_floor");
+
+static const QString SPARSE_KEY = QStringLiteral("sparse");
+static const QString BINS_KEY = QStringLiteral("bins");
+
 static const QString HOST_NAME_KEY = QStringLiteral("hostname");
 static const QString UPTIME_KEY = QStringLiteral("uptime");
 static const QString CPU_ARCHITECTURE_KEY = QStringLiteral("cpu_arch");
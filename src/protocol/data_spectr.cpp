@@ -12,12 +12,14 @@ public:
     data_spectr_data(): QSharedData()
     {
         m_valid = false;
+        m_sparse = false;
         m_powers.clear();
         m_id_params.clear();
     }
     data_spectr_data(const data_spectr_data &other) : QSharedData(other)
     {
         m_valid = other.m_valid;
+        m_sparse = other.m_sparse;
         m_id_params = other.m_id_params;
         m_powers = other.m_powers;
     }
@@ -25,6 +27,7 @@ public:
     ~data_spectr_data() {}
 
     bool m_valid;
+    bool m_sparse;
     QString m_id_params;
     QVector<power_spectr> m_powers;
 };
@@ -60,16 +63,36 @@ data_spectr::data_spectr(const QByteArray &json) : data(new data_spectr_data)
         powerSpectr.hz_high = objectPowerSpectr.value(FREQUENCY_MAX_KEY).toString().toULongLong();
 
         const QString valuePower = objectPowerSpectr.value(DATA_KEY).toString();
-        QStringList listValue(valuePower.split(";"));
 
-        for(const auto &strItem : listValue){
-            const auto value = static_cast<qreal>(strItem.trimmed().toFloat());
-            powerSpectr.m_power.append(value);
-        }        
+        // empty for a sparse segment without changes
+        if(!valuePower.isEmpty())
+        {
+            QStringList listValue(valuePower.split(";"));
+
+            for(const auto &strItem : listValue){
+                const auto value = static_cast<qreal>(strItem.trimmed().toFloat());
+                powerSpectr.m_power.append(value);
+            }
+        }
+
+        const QString valueBins = objectPowerSpectr.value(BINS_KEY).toString();
+
+        if(!valueBins.isEmpty())
+            for(const auto &strItem : valueBins.split(";"))
+                powerSpectr.m_bins.append(strItem.trimmed().toUInt());
+
+        // optional series
+        const QString valueNoiseFloor = objectPowerSpectr.value(NOISE_FLOOR_KEY).toString();
+
+        if(!valueNoiseFloor.isEmpty())
+            for(const auto &strItem : valueNoiseFloor.split(";"))
+                powerSpectr.m_noise_floor.append(static_cast<qreal>(strItem.trimmed().toFloat()));
+
         data->m_powers.append(powerSpectr);       
     }
 
     data->m_id_params = json_object.value(ID_PARAMS_KEY).toString();
+    data->m_sparse = json_object.value(SPARSE_KEY).toBool(false);
 
     if(!doc.isEmpty())
         data->m_valid = true;
@@ -114,6 +137,16 @@ QVector<power_spectr> data_spectr::spectr() const
     return data->m_powers;
 }
 
+void data_spectr::set_sparse(const bool &value)
+{
+    data->m_sparse = value;
+}
+
+bool data_spectr::is_sparse() const
+{
+    return data->m_sparse;
+}
+
 QByteArray data_spectr::to_json() const
 {
     QJsonObject json_object;
@@ -138,11 +171,32 @@ QByteArray data_spectr::to_json() const
 
             objectPowerSpectr.insert(DATA_KEY, list.join(";"));
 
+            if(data->m_sparse)
+            {
+                QStringList list_bins;
+                for(int w=0; w<powerSpectr.m_bins.count(); ++w)
+                    list_bins.append(QString::number(powerSpectr.m_bins.at(w)));
+
+                objectPowerSpectr.insert(BINS_KEY, list_bins.join(";"));
+            }
+
+            if(!powerSpectr.m_noise_floor.isEmpty())
+            {
+                QStringList list_noise_floor;
+                for(int w=0; w<powerSpectr.m_noise_floor.count(); ++w)
+                    list_noise_floor.append(QString::number(powerSpectr.m_noise_floor.at(w)));
+
+                objectPowerSpectr.insert(NOISE_FLOOR_KEY, list_noise_floor.join(";"));
+            }
+
             array.append(objectPowerSpectr);
         }
         json_object.insert(POWERS_KEY, array);
 
         json_object.insert(ID_PARAMS_KEY, data->m_id_params);
+
+        if(data->m_sparse)
+            json_object.insert(SPARSE_KEY, true);
     }
 
     const QJsonDocument doc(json_object);
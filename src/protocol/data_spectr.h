@@ -14,6 +14,8 @@ struct power_spectr
     quint64 hz_low = 0;    // frequency min Hz
     quint64 hz_high = 0;    // frequency max Hz
     QVector<qreal> m_power;
+    QVector<qreal> m_noise_floor;   // optional, per bin (dBm)
+    QVector<quint32> m_bins;        // sparse update: bin index of each m_power value
     power_spectr() {}
 };
 
@@ -36,6 +38,10 @@ public:
     void set_spectr(const QVector<power_spectr> &);
     QVector<power_spectr> spectr()const;
 
+    // only changed bins (power_spectr::m_bins), see spectr_sparse.h
+    void set_sparse(const bool &);
+    bool is_sparse()const;
+
     QByteArray to_json() const;
 
 private:
@@ -0,0 +1,292 @@
+#include "occupancy_spectr.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#include "constkeys.h"
+
+static QString join_values(const QVector<qreal> &values)
+{
+    QStringList list;
+
+    for(int i=0; i<values.size(); ++i)
+        list.append(QString::number(values.at(i)));
+
+    return list.join(";");
+}
+
+static QVector<qreal> split_values(const QString &value)
+{
+    QVector<qreal> values;
+
+    if(value.isEmpty())
+        return values;
+
+    const QStringList list(value.split(";"));
+    values.reserve(list.size());
+
+    for(const auto &str_item : list)
+        values.append(str_item.trimmed().toDouble());
+
+    return values;
+}
+
+class occupancy_spectr_data : public QSharedData {
+public:
+    occupancy_spectr_data(): QSharedData()
+    {
+        m_valid = false;
+        m_id_params.clear();
+        m_window = 0;
+        m_hz_low = 0;
+        m_hz_high = 0;
+        m_fft_bin_width = 0;
+        m_threshold = 0;
+        m_sweep_count = 0;
+    }
+    occupancy_spectr_data(const occupancy_spectr_data &other) : QSharedData(other)
+    {
+        m_valid = other.m_valid;
+        m_id_params = other.m_id_params;
+        m_date_time = other.m_date_time;
+        m_window = other.m_window;
+        m_hz_low = other.m_hz_low;
+        m_hz_high = other.m_hz_high;
+        m_fft_bin_width = other.m_fft_bin_width;
+        m_threshold = other.m_threshold;
+        m_sweep_count = other.m_sweep_count;
+        m_occupancy = other.m_occupancy;
+        m_mean = other.m_mean;
+        m_max = other.m_max;
+        m_p50 = other.m_p50;
+        m_p90 = other.m_p90;
+    }
+
+    ~occupancy_spectr_data() {}
+
+    bool m_valid;
+    QString m_id_params;
+    QDateTime m_date_time;
+    qint32 m_window;
+    quint64 m_hz_low;
+    quint64 m_hz_high;
+    qreal m_fft_bin_width;
+    qreal m_threshold;
+    qint64 m_sweep_count;
+    QVector<qreal> m_occupancy;
+    QVector<qreal> m_mean;
+    QVector<qreal> m_max;
+    QVector<qreal> m_p50;
+    QVector<qreal> m_p90;
+};
+
+occupancy_spectr::occupancy_spectr() : data(new occupancy_spectr_data)
+{
+}
+
+occupancy_spectr::occupancy_spectr(const occupancy_spectr &rhs) : data(rhs.data)
+{
+}
+
+occupancy_spectr::occupancy_spectr(const QByteArray &json) : data(new occupancy_spectr_data)
+{
+    QJsonDocument doc;
+
+    doc = QJsonDocument::fromJson(json);
+
+    const QJsonObject json_object(doc.object());
+
+    data->m_id_params = json_object.value(ID_PARAMS_KEY).toString();
+
+    auto dt = QDateTime::fromString(json_object.value(DT_KEY).toString(), DT_FORMAT);
+    dt.setTimeSpec(Qt::UTC);
+    data->m_date_time = dt;
+
+    data->m_window = json_object.value(WINDOW_KEY).toInt(0);
+    data->m_hz_low = json_object.value(FREQUENCY_MIN_KEY).toString().toULongLong();
+    data->m_hz_high = json_object.value(FREQUENCY_MAX_KEY).toString().toULongLong();
+    data->m_fft_bin_width = json_object.value(FFT_BIN_WIDTH_KEY).toString().toDouble();
+    data->m_threshold = json_object.value(THRESHOLD_KEY).toDouble(0);
+    data->m_sweep_count = json_object.value(SWEEP_COUNT_KEY).toString().toLongLong();
+    data->m_occupancy = split_values(json_object.value(OCCUPANCY_KEY).toString());
+    data->m_mean = split_values(json_object.value(MEAN_KEY).toString());
+    data->m_max = split_values(json_object.value(MAX_KEY).toString());
+    data->m_p50 = split_values(json_object.value(P50_KEY).toString());
+    data->m_p90 = split_values(json_object.value(P90_KEY).toString());
+
+    if(!doc.isEmpty())
+        data->m_valid = true;
+    else
+        data->m_valid = false;
+}
+
+occupancy_spectr &occupancy_spectr::operator=(const occupancy_spectr &rhs)
+{
+    if (this != &rhs) {
+        data.operator=(rhs.data);
+    }
+    return *this;
+}
+
+occupancy_spectr::~occupancy_spectr()
+{
+}
+
+bool occupancy_spectr::is_valid() const
+{
+    return data->m_valid;
+}
+
+void occupancy_spectr::set_id_params(const QString &value)
+{
+    data->m_id_params = value;
+}
+
+QString occupancy_spectr::id_params() const
+{
+    return data->m_id_params;
+}
+
+void occupancy_spectr::set_date_time(const QDateTime &value)
+{
+    data->m_date_time = value;
+}
+
+QDateTime occupancy_spectr::date_time() const
+{
+    return data->m_date_time;
+}
+
+void occupancy_spectr::set_window(const qint32 &value)
+{
+    data->m_window = value;
+}
+
+qint32 occupancy_spectr::window() const
+{
+    return data->m_window;
+}
+
+void occupancy_spectr::set_hz_low(const quint64 &value)
+{
+    data->m_hz_low = value;
+}
+
+quint64 occupancy_spectr::hz_low() const
+{
+    return data->m_hz_low;
+}
+
+void occupancy_spectr::set_hz_high(const quint64 &value)
+{
+    data->m_hz_high = value;
+}
+
+quint64 occupancy_spectr::hz_high() const
+{
+    return data->m_hz_high;
+}
+
+void occupancy_spectr::set_fft_bin_width(const qreal &value)
+{
+    data->m_fft_bin_width = value;
+}
+
+qreal occupancy_spectr::fft_bin_width() const
+{
+    return data->m_fft_bin_width;
+}
+
+void occupancy_spectr::set_threshold(const qreal &value)
+{
+    data->m_threshold = value;
+}
+
+qreal occupancy_spectr::threshold() const
+{
+    return data->m_threshold;
+}
+
+void occupancy_spectr::set_sweep_count(const qint64 &value)
+{
+    data->m_sweep_count = value;
+}
+
+qint64 occupancy_spectr::sweep_count() const
+{
+    return data->m_sweep_count;
+}
+
+void occupancy_spectr::set_occupancy(const QVector<qreal> &value)
+{
+    data->m_occupancy = value;
+}
+
+QVector<qreal> occupancy_spectr::occupancy() const
+{
+    return data->m_occupancy;
+}
+
+void occupancy_spectr::set_mean(const QVector<qreal> &value)
+{
+    data->m_mean = value;
+}
+
+QVector<qreal> occupancy_spectr::mean() const
+{
+    return data->m_mean;
+}
+
+void occupancy_spectr::set_max(const QVector<qreal> &value)
+{
+    data->m_max = value;
+}
+
+QVector<qreal> occupancy_spectr::max() const
+{
+    return data->m_max;
+}
+
+void occupancy_spectr::set_p50(const QVector<qreal> &value)
+{
+    data->m_p50 = value;
+}
+
+QVector<qreal> occupancy_spectr::p50() const
+{
+    return data->m_p50;
+}
+
+void occupancy_spectr::set_p90(const QVector<qreal> &value)
+{
+    data->m_p90 = value;
+}
+
+QVector<qreal> occupancy_spectr::p90() const
+{
+    return data->m_p90;
+}
+
+QByteArray occupancy_spectr::to_json() const
+{
+    QJsonObject json_object;
+
+    json_object.insert(ID_PARAMS_KEY, data->m_id_params);
+    json_object.insert(DT_KEY, data->m_date_time.toUTC().toString(DT_FORMAT));
+    json_object.insert(WINDOW_KEY, data->m_window);
+    json_object.insert(FREQUENCY_MIN_KEY, QString::number(data->m_hz_low));
+    json_object.insert(FREQUENCY_MAX_KEY, QString::number(data->m_hz_high));
+    json_object.insert(FFT_BIN_WIDTH_KEY, QString::number(data->m_fft_bin_width));
+    json_object.insert(THRESHOLD_KEY, data->m_threshold);
+    json_object.insert(SWEEP_COUNT_KEY, QString::number(data->m_sweep_count));
+    json_object.insert(OCCUPANCY_KEY, join_values(data->m_occupancy));
+    json_object.insert(MEAN_KEY, join_values(data->m_mean));
+    json_object.insert(MAX_KEY, join_values(data->m_max));
+    json_object.insert(P50_KEY, join_values(data->m_p50));
+    json_object.insert(P90_KEY, join_values(data->m_p90));
+
+    const QJsonDocument doc(json_object);
+
+    return doc.toJson(QJsonDocument::Compact);
+}
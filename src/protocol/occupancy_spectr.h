@@ -0,0 +1,71 @@
+#ifndef OCCUPANCY_SPECTR_H
+#define OCCUPANCY_SPECTR_H
+
+#include <QSharedData>
+#include <QMetaType>
+#include <QDateTime>
+#include <QVector>
+
+class occupancy_spectr_data;
+
+// per bin statistics of one params_id over one window
+class occupancy_spectr
+{
+public:
+    occupancy_spectr();
+    occupancy_spectr(const occupancy_spectr &);
+    occupancy_spectr(const QByteArray &json);
+    occupancy_spectr &operator=(const occupancy_spectr &);
+    ~occupancy_spectr();
+
+    bool is_valid() const;
+
+    void set_id_params(const QString &);
+    QString id_params()const;
+
+    void set_date_time(const QDateTime &);      // window start (UTC)
+    QDateTime date_time()const;
+
+    void set_window(const qint32 &);            // s
+    qint32 window()const;
+
+    void set_hz_low(const quint64 &);
+    quint64 hz_low()const;
+
+    void set_hz_high(const quint64 &);
+    quint64 hz_high()const;
+
+    void set_fft_bin_width(const qreal &);
+    qreal fft_bin_width()const;
+
+    void set_threshold(const qreal &);          // dBm
+    qreal threshold()const;
+
+    void set_sweep_count(const qint64 &);
+    qint64 sweep_count()const;
+
+    // fraction of sweeps above threshold (0..1)
+    void set_occupancy(const QVector<qreal> &);
+    QVector<qreal> occupancy()const;
+
+    void set_mean(const QVector<qreal> &);
+    QVector<qreal> mean()const;
+
+    void set_max(const QVector<qreal> &);
+    QVector<qreal> max()const;
+
+    void set_p50(const QVector<qreal> &);
+    QVector<qreal> p50()const;
+
+    void set_p90(const QVector<qreal> &);
+    QVector<qreal> p90()const;
+
+    QByteArray to_json() const;
+
+private:
+    QSharedDataPointer<occupancy_spectr_data> data;
+};
+
+Q_DECLARE_METATYPE(occupancy_spectr)
+
+#endif // OCCUPANCY_SPECTR_H
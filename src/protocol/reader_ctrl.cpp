@@ -0,0 +1,209 @@
+#include "reader_ctrl.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "constkeys.h"
+
+class reader_ctrl_data : public QSharedData {
+public:
+    reader_ctrl_data(): QSharedData()
+    {
+        m_valid = false;
+        m_ctrl_type = reader_ctrl_type::unknown;
+        m_id_params.clear();
+        m_limit = 0;
+        m_hz_low = 0;
+        m_hz_high = 0;
+        m_file_name.clear();
+    }
+    reader_ctrl_data(const reader_ctrl_data &other) : QSharedData(other)
+    {
+        m_valid = other.m_valid;
+        m_ctrl_type = other.m_ctrl_type;
+        m_id_params = other.m_id_params;
+        m_dt_from = other.m_dt_from;
+        m_dt_to = other.m_dt_to;
+        m_limit = other.m_limit;
+        m_hz_low = other.m_hz_low;
+        m_hz_high = other.m_hz_high;
+        m_file_name = other.m_file_name;
+    }
+
+    ~reader_ctrl_data() {}
+
+    bool m_valid;
+    reader_ctrl_type m_ctrl_type;
+    QString m_id_params;
+    QDateTime m_dt_from;
+    QDateTime m_dt_to;
+    qint32 m_limit;
+    quint64 m_hz_low;
+    quint64 m_hz_high;
+    QString m_file_name;
+};
+
+reader_ctrl::reader_ctrl() : data(new reader_ctrl_data)
+{
+}
+
+reader_ctrl::reader_ctrl(const reader_ctrl &rhs) : data(rhs.data)
+{
+}
+
+reader_ctrl::reader_ctrl(const QByteArray &json) : data(new reader_ctrl_data)
+{
+    QJsonDocument doc;
+
+    doc = QJsonDocument::fromJson(json);
+
+    const QJsonObject json_object(doc.object());
+
+    data->m_ctrl_type = static_cast<reader_ctrl_type>(json_object.value(READER_CTRL_TYPE_KEY).toInt(0));
+    data->m_id_params = json_object.value(ID_PARAMS_KEY).toString();
+
+    auto dt_from = QDateTime::fromString(json_object.value(DT_FROM_KEY).toString(), DT_FORMAT);
+    dt_from.setTimeSpec(Qt::UTC);
+    data->m_dt_from = dt_from;
+
+    auto dt_to = QDateTime::fromString(json_object.value(DT_TO_KEY).toString(), DT_FORMAT);
+    dt_to.setTimeSpec(Qt::UTC);
+    data->m_dt_to = dt_to;
+
+    data->m_limit = json_object.value(LIMIT_KEY).toInt(0);
+    data->m_hz_low = json_object.value(FREQUENCY_MIN_KEY).toString().toULongLong();
+    data->m_hz_high = json_object.value(FREQUENCY_MAX_KEY).toString().toULongLong();
+    data->m_file_name = json_object.value(FILE_NAME_KEY).toString();
+
+    if(!doc.isEmpty())
+        data->m_valid = true;
+    else
+        data->m_valid = false;
+}
+
+reader_ctrl &reader_ctrl::operator=(const reader_ctrl &rhs)
+{
+    if (this != &rhs) {
+        data.operator=(rhs.data);
+    }
+    return *this;
+}
+
+reader_ctrl::~reader_ctrl()
+{
+}
+
+bool reader_ctrl::is_valid() const
+{
+    return data->m_valid;
+}
+
+void reader_ctrl::set_ctrl_type(const reader_ctrl_type &value)
+{
+    data->m_ctrl_type = value;
+}
+
+reader_ctrl_type reader_ctrl::ctrl_type() const
+{
+    return data->m_ctrl_type;
+}
+
+void reader_ctrl::set_id_params(const QString &value)
+{
+    data->m_id_params = value;
+}
+
+QString reader_ctrl::id_params() const
+{
+    return data->m_id_params;
+}
+
+void reader_ctrl::set_dt_from(const QDateTime &value)
+{
+    data->m_dt_from = value;
+}
+
+QDateTime reader_ctrl::dt_from() const
+{
+    return data->m_dt_from;
+}
+
+void reader_ctrl::set_dt_to(const QDateTime &value)
+{
+    data->m_dt_to = value;
+}
+
+QDateTime reader_ctrl::dt_to() const
+{
+    return data->m_dt_to;
+}
+
+void reader_ctrl::set_limit(const qint32 &value)
+{
+    data->m_limit = value;
+}
+
+qint32 reader_ctrl::limit() const
+{
+    return data->m_limit;
+}
+
+void reader_ctrl::set_hz_low(const quint64 &value)
+{
+    data->m_hz_low = value;
+}
+
+quint64 reader_ctrl::hz_low() const
+{
+    return data->m_hz_low;
+}
+
+void reader_ctrl::set_hz_high(const quint64 &value)
+{
+    data->m_hz_high = value;
+}
+
+quint64 reader_ctrl::hz_high() const
+{
+    return data->m_hz_high;
+}
+
+void reader_ctrl::set_file_name(const QString &value)
+{
+    data->m_file_name = value;
+}
+
+QString reader_ctrl::file_name() const
+{
+    return data->m_file_name;
+}
+
+QByteArray reader_ctrl::to_json() const
+{
+    QJsonObject json_object;
+
+    json_object.insert(READER_CTRL_TYPE_KEY, static_cast<qint32>(data->m_ctrl_type));
+    json_object.insert(ID_PARAMS_KEY, data->m_id_params);
+
+    if(data->m_dt_from.isValid())
+        json_object.insert(DT_FROM_KEY, data->m_dt_from.toUTC().toString(DT_FORMAT));
+
+    if(data->m_dt_to.isValid())
+        json_object.insert(DT_TO_KEY, data->m_dt_to.toUTC().toString(DT_FORMAT));
+
+    if(data->m_limit > 0)
+        json_object.insert(LIMIT_KEY, data->m_limit);
+
+    if(data->m_hz_low > 0)
+        json_object.insert(FREQUENCY_MIN_KEY, QString::number(data->m_hz_low));
+
+    if(data->m_hz_high > 0)
+        json_object.insert(FREQUENCY_MAX_KEY, QString::number(data->m_hz_high));
+
+    if(!data->m_file_name.isEmpty())
+        json_object.insert(FILE_NAME_KEY, data->m_file_name);
+
+    const QJsonDocument doc(json_object);
+
+    return doc.toJson(QJsonDocument::Compact);
+}
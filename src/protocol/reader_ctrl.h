@@ -0,0 +1,62 @@
+#ifndef READER_CTRL_H
+#define READER_CTRL_H
+
+#include <QSharedData>
+#include <QMetaType>
+#include <QDateTime>
+
+enum class reader_ctrl_type: qint32 {
+    unknown,
+    occupancy,
+    export_spectr       // recorded sweeps to a binary matrix file (db export worker)
+};
+
+class reader_ctrl_data;
+
+// request to qsweepwrite (reader worker), result on topic "/db/reader"
+class reader_ctrl
+{
+public:
+    reader_ctrl();
+    reader_ctrl(const reader_ctrl &);
+    reader_ctrl(const QByteArray &json);
+    reader_ctrl &operator=(const reader_ctrl &);
+    ~reader_ctrl();
+
+    bool is_valid() const;
+
+    void set_ctrl_type(const reader_ctrl_type &);
+    reader_ctrl_type ctrl_type()const;
+
+    void set_id_params(const QString &);
+    QString id_params()const;
+
+    void set_dt_from(const QDateTime &);
+    QDateTime dt_from()const;
+
+    void set_dt_to(const QDateTime &);
+    QDateTime dt_to()const;
+
+    void set_limit(const qint32 &);
+    qint32 limit()const;
+
+    // frequency window (Hz), 0 - whole sweep
+    void set_hz_low(const quint64 &);
+    quint64 hz_low()const;
+
+    void set_hz_high(const quint64 &);
+    quint64 hz_high()const;
+
+    // base name of the export files (in export_path of qsweepwrite)
+    void set_file_name(const QString &);
+    QString file_name()const;
+
+    QByteArray to_json() const;
+
+private:
+    QSharedDataPointer<reader_ctrl_data> data;
+};
+
+Q_DECLARE_METATYPE(reader_ctrl)
+
+#endif // READER_CTRL_H
@@ -0,0 +1,233 @@
+#include "spectr_event.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "constkeys.h"
+
+class spectr_event_data : public QSharedData {
+public:
+    spectr_event_data(): QSharedData()
+    {
+        m_valid = false;
+        m_id_params.clear();
+        m_event_id = 0;
+        m_state = event_state::unknown;
+        m_hz_center = 0;
+        m_hz_peak = 0;
+        m_bandwidth = 0;
+        m_peak_power = 0;
+        m_noise_floor = 0;
+    }
+    spectr_event_data(const spectr_event_data &other) : QSharedData(other)
+    {
+        m_valid = other.m_valid;
+        m_id_params = other.m_id_params;
+        m_event_id = other.m_event_id;
+        m_state = other.m_state;
+        m_dt_start = other.m_dt_start;
+        m_dt_stop = other.m_dt_stop;
+        m_hz_center = other.m_hz_center;
+        m_hz_peak = other.m_hz_peak;
+        m_bandwidth = other.m_bandwidth;
+        m_peak_power = other.m_peak_power;
+        m_noise_floor = other.m_noise_floor;
+    }
+
+    ~spectr_event_data() {}
+
+    bool m_valid;
+    QString m_id_params;
+    quint64 m_event_id;
+    event_state m_state;
+    QDateTime m_dt_start;
+    QDateTime m_dt_stop;
+    quint64 m_hz_center;
+    quint64 m_hz_peak;
+    quint64 m_bandwidth;
+    qreal m_peak_power;
+    qreal m_noise_floor;
+};
+
+spectr_event::spectr_event() : data(new spectr_event_data)
+{
+}
+
+spectr_event::spectr_event(const spectr_event &rhs) : data(rhs.data)
+{
+}
+
+spectr_event::spectr_event(const QByteArray &json) : data(new spectr_event_data)
+{
+    QJsonDocument doc;
+
+    doc = QJsonDocument::fromJson(json);
+
+    const QJsonObject json_object(doc.object());
+
+    data->m_id_params = json_object.value(ID_PARAMS_KEY).toString();
+    data->m_event_id = json_object.value(EVENT_ID_KEY).toString().toULongLong();
+    data->m_state = static_cast<event_state>(json_object.value(EVENT_STATE_KEY).toInt(0));
+
+    auto dt_start = QDateTime::fromString(json_object.value(DT_START_KEY).toString(), DT_FORMAT);
+    dt_start.setTimeSpec(Qt::UTC);
+    data->m_dt_start = dt_start;
+
+    if(json_object.contains(DT_STOP_KEY))
+    {
+        auto dt_stop = QDateTime::fromString(json_object.value(DT_STOP_KEY).toString(), DT_FORMAT);
+        dt_stop.setTimeSpec(Qt::UTC);
+        data->m_dt_stop = dt_stop;
+    }
+
+    data->m_hz_center = json_object.value(FREQUENCY_CENTER_KEY).toString().toULongLong();
+    data->m_hz_peak = json_object.value(FREQUENCY_PEAK_KEY).toString().toULongLong();
+    data->m_bandwidth = json_object.value(BANDWIDTH_KEY).toString().toULongLong();
+    data->m_peak_power = json_object.value(PEAK_POWER_KEY).toDouble(0);
+    data->m_noise_floor = json_object.value(NOISE_FLOOR_KEY).toDouble(0);
+
+    if(!doc.isEmpty())
+        data->m_valid = true;
+    else
+        data->m_valid = false;
+}
+
+spectr_event &spectr_event::operator=(const spectr_event &rhs)
+{
+    if (this != &rhs) {
+        data.operator=(rhs.data);
+    }
+    return *this;
+}
+
+spectr_event::~spectr_event()
+{
+}
+
+bool spectr_event::is_valid() const
+{
+    return data->m_valid;
+}
+
+void spectr_event::set_id_params(const QString &value)
+{
+    data->m_id_params = value;
+}
+
+QString spectr_event::id_params() const
+{
+    return data->m_id_params;
+}
+
+void spectr_event::set_event_id(const quint64 &value)
+{
+    data->m_event_id = value;
+}
+
+quint64 spectr_event::event_id() const
+{
+    return data->m_event_id;
+}
+
+void spectr_event::set_state(const event_state &value)
+{
+    data->m_state = value;
+}
+
+event_state spectr_event::state() const
+{
+    return data->m_state;
+}
+
+void spectr_event::set_dt_start(const QDateTime &value)
+{
+    data->m_dt_start = value;
+}
+
+QDateTime spectr_event::dt_start() const
+{
+    return data->m_dt_start;
+}
+
+void spectr_event::set_dt_stop(const QDateTime &value)
+{
+    data->m_dt_stop = value;
+}
+
+QDateTime spectr_event::dt_stop() const
+{
+    return data->m_dt_stop;
+}
+
+void spectr_event::set_hz_center(const quint64 &value)
+{
+    data->m_hz_center = value;
+}
+
+quint64 spectr_event::hz_center() const
+{
+    return data->m_hz_center;
+}
+
+void spectr_event::set_hz_peak(const quint64 &value)
+{
+    data->m_hz_peak = value;
+}
+
+quint64 spectr_event::hz_peak() const
+{
+    return data->m_hz_peak;
+}
+
+void spectr_event::set_bandwidth(const quint64 &value)
+{
+    data->m_bandwidth = value;
+}
+
+quint64 spectr_event::bandwidth() const
+{
+    return data->m_bandwidth;
+}
+
+void spectr_event::set_peak_power(const qreal &value)
+{
+    data->m_peak_power = value;
+}
+
+qreal spectr_event::peak_power() const
+{
+    return data->m_peak_power;
+}
+
+void spectr_event::set_noise_floor(const qreal &value)
+{
+    data->m_noise_floor = value;
+}
+
+qreal spectr_event::noise_floor() const
+{
+    return data->m_noise_floor;
+}
+
+QByteArray spectr_event::to_json() const
+{
+    QJsonObject json_object;
+
+    json_object.insert(ID_PARAMS_KEY, data->m_id_params);
+    json_object.insert(EVENT_ID_KEY, QString::number(data->m_event_id));
+    json_object.insert(EVENT_STATE_KEY, static_cast<qint32>(data->m_state));
+    json_object.insert(DT_START_KEY, data->m_dt_start.toUTC().toString(DT_FORMAT));
+
+    if(data->m_dt_stop.isValid())
+        json_object.insert(DT_STOP_KEY, data->m_dt_stop.toUTC().toString(DT_FORMAT));
+
+    json_object.insert(FREQUENCY_CENTER_KEY, QString::number(data->m_hz_center));
+    json_object.insert(FREQUENCY_PEAK_KEY, QString::number(data->m_hz_peak));
+    json_object.insert(BANDWIDTH_KEY, QString::number(data->m_bandwidth));
+    json_object.insert(PEAK_POWER_KEY, data->m_peak_power);
+    json_object.insert(NOISE_FLOOR_KEY, data->m_noise_floor);
+
+    const QJsonDocument doc(json_object);
+
+    return doc.toJson(QJsonDocument::Compact);
+}
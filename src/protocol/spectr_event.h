@@ -0,0 +1,66 @@
+#ifndef SPECTR_EVENT_H
+#define SPECTR_EVENT_H
+
+#include <QSharedData>
+#include <QMetaType>
+#include <QDateTime>
+
+enum class event_state: qint32 {
+    unknown,
+    start,
+    stop
+};
+
+class spectr_event_data;
+
+// detected emission (tracked across sweeps)
+class spectr_event
+{
+public:
+    spectr_event();
+    spectr_event(const spectr_event &);
+    spectr_event(const QByteArray &json);
+    spectr_event &operator=(const spectr_event &);
+    ~spectr_event();
+
+    bool is_valid() const;
+
+    void set_id_params(const QString &);
+    QString id_params()const;
+
+    void set_event_id(const quint64 &);
+    quint64 event_id()const;
+
+    void set_state(const event_state &);
+    event_state state()const;
+
+    void set_dt_start(const QDateTime &);
+    QDateTime dt_start()const;
+
+    void set_dt_stop(const QDateTime &);        // valid for event_state::stop
+    QDateTime dt_stop()const;
+
+    void set_hz_center(const quint64 &);        // middle of the detected band
+    quint64 hz_center()const;
+
+    void set_hz_peak(const quint64 &);          // frequency of max power
+    quint64 hz_peak()const;
+
+    void set_bandwidth(const quint64 &);        // Hz
+    quint64 bandwidth()const;
+
+    void set_peak_power(const qreal &);         // dBm
+    qreal peak_power()const;
+
+    void set_noise_floor(const qreal &);        // dBm
+    qreal noise_floor()const;
+
+    QByteArray to_json() const;
+
+private:
+    QSharedDataPointer<spectr_event_data> data;
+};
+
+Q_DECLARE_METATYPE(spectr_event)
+
+#endif // SPECTR_EVENT_H
@@ -0,0 +1,159 @@
+#include "spectr_sparse.h"
+
+void sparse_encoder::set_threshold(const qreal &value)
+{
+    m_threshold = qMax(0.0, value);
+}
+
+void sparse_encoder::set_refresh(const qint32 &value)
+{
+    m_refresh = qMax(1, value);
+}
+
+data_spectr sparse_encoder::encode(const data_spectr &full)
+{
+    const QVector<power_spectr> powers(full.spectr());
+
+    bool is_full(full.id_params() != m_id_params);
+    is_full |= (m_sweep_count % m_refresh) == 0;
+    is_full |= m_published.size() != powers.size();
+
+    for(int s=0; (s<powers.size())&&(!is_full); ++s)
+    {
+        const auto it = m_published.constFind(powers.at(s).hz_low);
+        is_full = (it == m_published.constEnd())||(it->size() != powers.at(s).m_power.size());
+        is_full |= is_floor_changed(powers.at(s));
+    }
+
+    if(is_full)
+    {
+        clear();
+        m_id_params = full.id_params();
+
+        for(const auto &power : powers)
+        {
+            m_published.insert(power.hz_low, power.m_power);
+            m_published_floor.insert(power.hz_low, power.m_noise_floor);
+        }
+
+        m_sweep_count = 1;
+
+        return full;
+    }
+
+    QVector<power_spectr> sparse_powers;
+    sparse_powers.reserve(powers.size());
+
+    for(const auto &power : powers)
+    {
+        QVector<qreal> &published = m_published[power.hz_low];
+
+        power_spectr sparse_power;
+        sparse_power.m_date_time = power.m_date_time;
+        sparse_power.hz_low = power.hz_low;
+        sparse_power.hz_high = power.hz_high;
+        sparse_power.m_fft_bin_width = power.m_fft_bin_width;
+        sparse_power.num_samples = power.num_samples;
+
+        for(int i=0; i<power.m_power.size(); ++i)
+        {
+            if(qAbs(power.m_power.at(i) - published.at(i)) > m_threshold)
+            {
+                published[i] = power.m_power.at(i);
+                sparse_power.m_power.append(power.m_power.at(i));
+                sparse_power.m_bins.append(static_cast<quint32>(i));
+            }
+        }
+
+        // segment is kept even without changes (sweep time, layout)
+        sparse_powers.append(sparse_power);
+    }
+
+    m_sweep_count++;
+
+    data_spectr sparse;
+    sparse.set_id_params(full.id_params());
+    sparse.set_spectr(sparse_powers);
+    sparse.set_sparse(true);
+
+    return sparse;
+}
+
+void sparse_encoder::clear()
+{
+    m_published.clear();
+    m_published_floor.clear();
+    m_id_params.clear();
+    m_sweep_count = 0;
+}
+
+bool sparse_encoder::is_floor_changed(const power_spectr &power) const
+{
+    const QVector<qreal> floor = m_published_floor.value(power.hz_low);
+
+    if(floor.size() != power.m_noise_floor.size())
+        return true;
+
+    for(int i=0; i<floor.size(); ++i)
+        if(qAbs(power.m_noise_floor.at(i) - floor.at(i)) > m_threshold)
+            return true;
+
+    return false;
+}
+
+bool sparse_decoder::decode(data_spectr &data)
+{
+    QVector<power_spectr> powers(data.spectr());
+
+    if(!data.is_sparse())
+    {
+        QHash<quint64, power_spectr> &segments = m_segments[data.id_params()];
+        segments.clear();
+
+        for(const auto &power : powers)
+            segments.insert(power.hz_low, power);
+
+        return true;
+    }
+
+    auto it = m_segments.find(data.id_params());
+
+    if(it == m_segments.end())
+        return false;
+
+    QHash<quint64, power_spectr> &segments = it.value();
+
+    for(const auto &power : powers)
+        if(!segments.contains(power.hz_low))
+            return false;
+
+    for(int s=0; s<powers.size(); ++s)
+    {
+        power_spectr &segment = segments[powers.at(s).hz_low];
+        const power_spectr &update = powers.at(s);
+        const int size = qMin(update.m_power.size(), update.m_bins.size());
+
+        for(int i=0; i<size; ++i)
+        {
+            const int bin = static_cast<int>(update.m_bins.at(i));
+
+            if(bin < segment.m_power.size())
+                segment.m_power[bin] = update.m_power.at(i);
+        }
+
+        segment.m_date_time = update.m_date_time;
+        segment.num_samples = update.num_samples;
+
+        powers[s] = segment;
+    }
+
+    data.set_spectr(powers);
+    data.set_sparse(false);
+
+    return true;
+}
+
+void sparse_decoder::clear()
+{
+    m_segments.clear();
+}
@@ -0,0 +1,52 @@
+#ifndef SPECTR_SPARSE_H
+#define SPECTR_SPARSE_H
+
+#include <QHash>
+#include <QVector>
+
+#include "data_spectr.h"
+
+// sparse update of data_spectr: only the bins whose power changed by more
+// than "threshold" dB since the last published value, plus a full sweep
+// every "refresh" sweeps (and on new params or a new segment layout).
+// Sparse segments carry no noise floor: a noise floor bin changed by more
+// than "threshold" dB forces a full sweep, so the decoder floor is never stale
+
+// publisher side (qsweepserver)
+class sparse_encoder
+{
+public:
+    void set_threshold(const qreal &);
+    void set_refresh(const qint32 &);
+
+    data_spectr encode(const data_spectr &full);
+    void clear();
+
+private:
+    qreal m_threshold = 1.0;
+    qint32 m_refresh = 20;
+    qint32 m_sweep_count = 0;
+    QString m_id_params;
+
+    // last published value by segment (hz_low)
+    QHash<quint64, QVector<qreal> > m_published;
+    QHash<quint64, QVector<qreal> > m_published_floor;
+
+    bool is_floor_changed(const power_spectr &)const;
+};
+
+// subscriber side (qsweepclient, qsweepwrite): rebuilds the full sweep,
+// sparse updates are dropped until the first full sweep of the params
+class sparse_decoder
+{
+public:
+    // false if "data" can not be rebuilt
+    bool decode(data_spectr &data);
+    void clear();
+
+private:
+    // last full segment by params_id and hz_low (several servers on one topic)
+    QHash<QString, QHash<quint64, power_spectr> > m_segments;
+};
+
+#endif // SPECTR_SPARSE_H
@@ -14,6 +14,7 @@ public:
         m_id = QUuid::createUuid().toString().mid(1, 8);
         m_data.clear();
         m_type = type_message::unknown;
+        m_route_hz = 0;
     }
     sweep_message_data(const sweep_message_data &other) : QSharedData(other)
     {
@@ -21,6 +22,8 @@ public:
         m_id = other.m_id;
         m_data = other.m_data;
         m_type = other.m_type;
+        m_route_id = other.m_route_id;
+        m_route_hz = other.m_route_hz;
     }
 
     ~sweep_message_data() {}
@@ -29,8 +32,29 @@ public:
     QString m_id;
     QByteArray m_data;
     type_message m_type;
+    QString m_route_id;
+    quint64 m_route_hz;
 };
 
+// value of a top level string key, searched from the end: the route keys
+// follow "data" (keys are sorted) and base64 has no quotes
+static QByteArray peek_string(const QByteArray &json, const QString &key)
+{
+    const QByteArray pattern = "\"" + key.toLatin1() + "\":\"";
+    const int from = json.lastIndexOf(pattern);
+
+    if(from < 0)
+        return QByteArray();
+
+    const int begin = from + pattern.size();
+    const int end = json.indexOf('"', begin);
+
+    if(end < 0)
+        return QByteArray();
+
+    return json.mid(begin, end - begin);
+}
+
 sweep_message::sweep_message() : data(new sweep_message_data)
 {
 }
@@ -56,6 +80,8 @@ sweep_message::sweep_message(const QByteArray &json) : data(new sweep_message_da
     const QJsonObject json_object(doc.object());
     data->m_id = json_object.value(ID_KEY).toString();
     data->m_type = static_cast<type_message>(json_object.value(TYPE_MESSAGE_KEY).toInt(0));
+    data->m_route_id = json_object.value(ROUTE_ID_KEY).toString();
+    data->m_route_hz = json_object.value(ROUTE_HZ_KEY).toString().toULongLong();
 
     QByteArray ba;
     ba.append(json_object.value(DATA_KEY).toString().toUtf8());
@@ -101,6 +127,22 @@ QByteArray sweep_message::data_message() const
     return  data->m_data;
 }
 
+void sweep_message::set_route(const QString &id, const quint64 &hz_low)
+{
+    data->m_route_id = id;
+    data->m_route_hz = hz_low;
+}
+
+QString sweep_message::route_id() const
+{
+    return data->m_route_id;
+}
+
+quint64 sweep_message::route_hz() const
+{
+    return data->m_route_hz;
+}
+
 QByteArray sweep_message::to_json() const
 {
     QJsonObject json_object;
@@ -109,7 +151,26 @@ QByteArray sweep_message::to_json() const
     json_object.insert(TYPE_MESSAGE_KEY, static_cast<qint32>(data->m_type));
     json_object.insert(DATA_KEY, QString(data->m_data.toBase64()));
 
+    if(!data->m_route_id.isEmpty())
+    {
+        json_object.insert(ROUTE_ID_KEY, data->m_route_id);
+        json_object.insert(ROUTE_HZ_KEY, QString::number(data->m_route_hz));
+    }
+
     const QJsonDocument doc(json_object);
 
     return doc.toJson(QJsonDocument::Compact);
 }
+
+bool sweep_message::peek_route(const QByteArray &json, QString &id, quint64 &hz_low)
+{
+    const QByteArray route_id = peek_string(json, ROUTE_ID_KEY);
+
+    if(route_id.isEmpty())
+        return false;
+
+    id = QString::fromUtf8(route_id);
+    hz_low = peek_string(json, ROUTE_HZ_KEY).toULongLong();
+
+    return true;
+}
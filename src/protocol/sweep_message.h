@@ -12,7 +12,10 @@ enum class type_message: qint32 {
     ctrl_db,
     data_spectr,
     data_message_log,
-    data_system_monitor
+    data_system_monitor,
+    ctrl_reader,
+    data_occupancy,
+    data_event
 };
 
 class sweep_message_data;
@@ -36,8 +39,16 @@ public:
     void set_data_message(const QByteArray &);
     QByteArray data_message()const;
 
+    // optional: params id and frequency (Hz) of the data, for routing
+    void set_route(const QString &id, const quint64 &hz_low);
+    QString route_id()const;
+    quint64 route_hz()const;
+
     QByteArray to_json() const;
 
+    // route of a message without parsing it (false if it has no route)
+    static bool peek_route(const QByteArray &json, QString &id, quint64 &hz_low);
+
 private:
     QSharedDataPointer<sweep_message_data> data;
 };
@@ -23,6 +23,10 @@ QString sweep_topic::sweep_topic_by_type(const topic value) const
         return str_topic_id + str_topic_db_ctrl;
     case topic_process_status:
         return str_topic_id + str_topic_process_status;
+    case topic_db_reader:
+        return str_topic_id + str_topic_db_reader;
+    case topic_event:
+        return str_topic_id + str_topic_event;
     default:
         break;
     }
@@ -56,6 +60,12 @@ sweep_topic::topic sweep_topic::sweep_topic_by_str(const QString &value)
     if(value == str_topic_id + str_topic_process_status)
         return topic_process_status;
 
+    if(value == str_topic_id + str_topic_db_reader)
+        return topic_db_reader;
+
+    if(value == str_topic_id + str_topic_event)
+        return topic_event;
+
     return topic_unknown;
 }
 
@@ -16,7 +16,9 @@ public:
         topic_info,
         topic_power_spectr,
         topic_system_monitor,
-        topic_process_status
+        topic_process_status,
+        topic_db_reader,
+        topic_event
     };
 
     explicit sweep_topic(QObject *parent = nullptr);
@@ -33,6 +35,10 @@ private:
     // ctrl
     QString str_topic_ctrl = QLatin1String("/ctrl");
     QString str_topic_db_ctrl = QLatin1String("/db/ctrl");
+    // db reader results
+    QString str_topic_db_reader = QLatin1String("/db/reader");
+    // detected emissions (start/stop)
+    QString str_topic_event = QLatin1String("/event");
     // data result
     QString str_topic_message_log = QLatin1String("/message/log");
     QString str_topic_info = QLatin1String("/info");
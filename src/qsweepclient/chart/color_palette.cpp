@@ -0,0 +1,160 @@
+#include "color_palette.h"
+
+namespace {
+
+struct palette_stop {
+    qreal m_position;
+    QRgb m_color;
+};
+
+// black, red, yellow, blue, white (the original waterfall gradient)
+const palette_stop classic_stops[] = {
+    {0.0, 0xff000000}, {0.2, 0xffff0000}, {0.4, 0xfffff000},
+    {0.6, 0xff0000ff}, {1.0, 0xffffffff}
+};
+
+// perceptual palettes (matplotlib), sampled
+const palette_stop viridis_stops[] = {
+    {0.000, 0xff440154}, {0.125, 0xff482878}, {0.250, 0xff3e4989},
+    {0.375, 0xff31688e}, {0.500, 0xff26828e}, {0.625, 0xff1f9e89},
+    {0.750, 0xff35b779}, {0.875, 0xff6ece58}, {1.000, 0xfffde725}
+};
+
+const palette_stop inferno_stops[] = {
+    {0.000, 0xff000004}, {0.125, 0xff1b0c41}, {0.250, 0xff4a0c6b},
+    {0.375, 0xff781c6d}, {0.500, 0xffa52c60}, {0.625, 0xffcf4446},
+    {0.750, 0xffed6925}, {0.875, 0xfffb9b06}, {1.000, 0xfffcffa4}
+};
+
+const palette_stop turbo_stops[] = {
+    {0.0, 0xff30123b}, {0.1, 0xff4454c4}, {0.2, 0xff4490fe},
+    {0.3, 0xff1fc8de}, {0.4, 0xff29efa2}, {0.5, 0xff7dff56},
+    {0.6, 0xffc1f334}, {0.7, 0xfff1ca3a}, {0.8, 0xfffe922a},
+    {0.9, 0xffea4f0d}, {1.0, 0xff7a0403}
+};
+
+template <int N>
+void fill_lut(QVector<QRgb> &lut, const palette_stop (&stops)[N])
+{
+    const int size = lut.size();
+    int stop = 0;
+
+    for(int i=0; i<size; ++i)
+    {
+        const qreal position = static_cast<qreal>(i)/(size - 1);
+
+        while((stop < N - 2)&&(position > stops[stop + 1].m_position))
+            ++stop;
+
+        const palette_stop &a = stops[stop];
+        const palette_stop &b = stops[stop + 1];
+        const qreal t = qBound(0.0, (position - a.m_position)/(b.m_position - a.m_position), 1.0);
+
+        lut[i] = qRgb(qRound(qRed(a.m_color) + (qRed(b.m_color) - qRed(a.m_color))*t),
+                      qRound(qGreen(a.m_color) + (qGreen(b.m_color) - qGreen(a.m_color))*t),
+                      qRound(qBlue(a.m_color) + (qBlue(b.m_color) - qBlue(a.m_color))*t));
+    }
+}
+
+}
+
+color_palette::color_palette()
+{
+    m_lut.resize(lut_size);
+    set_palette(palette_type::classic);
+    set_levels(-100, 0);
+}
+
+void color_palette::set_palette(const palette_type &value)
+{
+    m_palette = value;
+
+    switch (m_palette) {
+    case palette_type::viridis:
+        fill_lut(m_lut, viridis_stops);
+        break;
+    case palette_type::inferno:
+        fill_lut(m_lut, inferno_stops);
+        break;
+    case palette_type::turbo:
+        fill_lut(m_lut, turbo_stops);
+        break;
+    default:
+        m_palette = palette_type::classic;
+        fill_lut(m_lut, classic_stops);
+        break;
+    }
+}
+
+palette_type color_palette::palette() const
+{
+    return m_palette;
+}
+
+void color_palette::set_levels(const qreal &level_min, const qreal &level_max)
+{
+    // index = level * scale + offset
+    const qreal range = level_max > level_min ? level_max - level_min : 1;
+
+    m_scale = (lut_size - 1)/range;
+    m_offset = -level_min*m_scale;
+}
+
+QRgb color_palette::color(const qreal &level) const
+{
+    return m_lut.at(qBound(0, static_cast<int>(level*m_scale + m_offset), lut_size - 1));
+}
+
+void color_palette::map_row(const qreal *values, const int &size, QRgb *row, const int &width)
+{
+    if((!values)||(!row)||(size <= 0)||(width <= 0))
+        return;
+
+    if(m_levels.size() != width)
+    {
+        m_levels.resize(width);
+        m_index.resize(width);
+    }
+
+    float *levels = m_levels.data();
+    qint32 *index = m_index.data();
+
+    // bins -> one level per pixel (max of the bins under the pixel)
+    if(size <= width)
+    {
+        for(int x=0; x<width; ++x)
+            levels[x] = static_cast<float>(values[static_cast<qint64>(x)*size/width]);
+    }else{
+        for(int x=0; x<width; ++x)
+        {
+            const int first = static_cast<int>(static_cast<qint64>(x)*size/width);
+            const int last = static_cast<int>(static_cast<qint64>(x + 1)*size/width);
+
+            qreal level = values[first];
+
+            for(int i=first + 1; i<last; ++i)
+                level = qMax(level, values[i]);
+
+            levels[x] = static_cast<float>(level);
+        }
+    }
+
+    // level -> index (branch free, vectorizable)
+    const float scale = static_cast<float>(m_scale);
+    const float offset = static_cast<float>(m_offset);
+    const float index_max = static_cast<float>(lut_size - 1);
+
+    for(int x=0; x<width; ++x)
+    {
+        float value = levels[x]*scale + offset;
+        value = value < 0.0f ? 0.0f : value;
+        value = value > index_max ? index_max : value;
+        index[x] = static_cast<qint32>(value);
+    }
+
+    // index -> color
+    const QRgb *lut = m_lut.constData();
+
+    for(int x=0; x<width; ++x)
+        row[x] = lut[index[x]];
+}
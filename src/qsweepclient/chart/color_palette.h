@@ -0,0 +1,48 @@
+#ifndef COLOR_PALETTE_H
+#define COLOR_PALETTE_H
+
+#include <QVector>
+#include <QColor>
+
+// waterfall palettes
+enum class palette_type: qint32 {
+    classic = 0,
+    viridis,
+    inferno,
+    turbo
+};
+
+// color lookup table of the waterfall: levels (dB) are mapped linearly from
+// [level_min, level_max] to the table index, no per pixel log or painter.
+// map_row() writes a whole scanline: bins are reduced to one value per
+// pixel (max), then converted to indexes and colors in flat loops
+class color_palette
+{
+public:
+    color_palette();
+
+    static const int lut_size = 1024;
+
+    void set_palette(const palette_type &);
+    palette_type palette()const;
+
+    void set_levels(const qreal &level_min, const qreal &level_max);
+
+    QRgb color(const qreal &level)const;
+
+    // "size" bins to "width" pixels of "row"
+    void map_row(const qreal *values, const int &size, QRgb *row, const int &width);
+
+private:
+    palette_type m_palette;
+    QVector<QRgb> m_lut;
+
+    qreal m_scale {0};
+    qreal m_offset {0};
+
+    // scratch of map_row(), one level per pixel
+    QVector<float> m_levels;
+    QVector<qint32> m_index;
+};
+
+#endif // COLOR_PALETTE_H
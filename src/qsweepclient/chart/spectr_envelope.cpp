@@ -0,0 +1,89 @@
+#include "spectr_envelope.h"
+
+#include <QtCore/qmath.h>
+
+template <typename T>
+static QVector<QPointF> envelope(const T *values, const int &size, const QRectF &area,
+                                 const qreal &level_min, const qreal &level_max)
+{
+    QVector<QPointF> points;
+
+    if((!values)||(size <= 0)||area.isEmpty()||(level_max <= level_min))
+        return points;
+
+    const qreal scale_y = area.height()/(level_max - level_min);
+    const int columns = qMax(1, qFloor(area.width()));
+
+    auto level_y = [&](const T &value) {
+        return area.top() + (level_max - qBound(level_min, static_cast<qreal>(value), level_max))*scale_y;
+    };
+
+    // one point per bin
+    if(size <= columns)
+    {
+        const qreal step_x = size > 1 ? area.width()/(size - 1) : 0;
+
+        points.resize(size);
+
+        for(int i=0; i<size; ++i)
+            points[i] = QPointF(area.left() + i*step_x, level_y(values[i]));
+
+        return points;
+    }
+
+    // min/max per pixel column
+    points.reserve(columns*2);
+
+    const qreal step_x = columns > 1 ? area.width()/(columns - 1) : 0;
+
+    for(int c=0; c<columns; ++c)
+    {
+        const int first = static_cast<int>(static_cast<qint64>(c)*size/columns);
+        const int last = static_cast<int>(static_cast<qint64>(c + 1)*size/columns);
+
+        int index_min = first;
+        int index_max = first;
+
+        for(int i=first + 1; i<last; ++i)
+        {
+            if(values[i] < values[index_min])
+                index_min = i;
+
+            if(values[i] > values[index_max])
+                index_max = i;
+        }
+
+        const qreal x = area.left() + c*step_x;
+
+        if(index_min == index_max)
+        {
+            points.append(QPointF(x, level_y(values[index_min])));
+        }else if(index_min < index_max){
+            points.append(QPointF(x, level_y(values[index_min])));
+            points.append(QPointF(x, level_y(values[index_max])));
+        }else{
+            points.append(QPointF(x, level_y(values[index_max])));
+            points.append(QPointF(x, level_y(values[index_min])));
+        }
+    }
+
+    return points;
+}
+
+QVector<QPointF> envelope_points(const qreal *values, const int &size, const QRectF &area,
+                                 const qreal &level_min, const qreal &level_max)
+{
+    return envelope(values, size, area, level_min, level_max);
+}
+
+QVector<QPointF> envelope_points(const float *values, const int &size, const QRectF &area,
+                                 const qreal &level_min, const qreal &level_max)
+{
+    return envelope(values, size, area, level_min, level_max);
+}
+
+QVector<QPointF> envelope_points(const QVector<qreal> &values, const QRectF &area,
+                                 const qreal &level_min, const qreal &level_max)
+{
+    return envelope_points(values.constData(), values.size(), area, level_min, level_max);
+}
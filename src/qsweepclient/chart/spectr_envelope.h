@@ -0,0 +1,19 @@
+#ifndef SPECTR_ENVELOPE_H
+#define SPECTR_ENVELOPE_H
+
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+
+// trace points of "values" (dB) in "area": levels are mapped linearly from
+// [level_min, level_max] (clamped) to the area height. If there are more
+// bins than pixel columns, every column is reduced to its min and max
+// (in bin order), so narrow peaks stay visible: at most 2 x width points
+QVector<QPointF> envelope_points(const qreal *values, const int &size, const QRectF &area,
+                                 const qreal &level_min, const qreal &level_max);
+QVector<QPointF> envelope_points(const float *values, const int &size, const QRectF &area,
+                                 const qreal &level_min, const qreal &level_max);
+QVector<QPointF> envelope_points(const QVector<qreal> &values, const QRectF &area,
+                                 const qreal &level_min, const qreal &level_max);
+
+#endif // SPECTR_ENVELOPE_H
@@ -32,6 +32,11 @@ void spectr_item::set_raw_data(const QVector<QPointF> &data)
     m_data.append(data);
 }
 
+QVector<QPointF> spectr_item::raw_data() const
+{
+    return m_data;
+}
+
 qint32 spectr_item::raw_data_size() const
 {
     return m_data.size();
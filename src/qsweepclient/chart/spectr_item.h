@@ -20,6 +20,7 @@ public:
     Qt::PenStyle item_style()const;
 
     void set_raw_data(const QVector<QPointF> &data);
+    QVector<QPointF> raw_data()const;
 
     qint32 raw_data_size()const;
     QPointF raw_data_pos(const qint32 &index)const;
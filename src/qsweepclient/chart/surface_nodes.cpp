@@ -0,0 +1,303 @@
+#include "surface_nodes.h"
+
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+
+static QOpenGLFunctions *gl_functions()
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+
+    return context ? context->functions() : Q_NULLPTR;
+}
+
+waterfall_texture::waterfall_texture()
+{
+    setFiltering(QSGTexture::Linear);
+    setHorizontalWrapMode(QSGTexture::ClampToEdge);
+    setVerticalWrapMode(QSGTexture::ClampToEdge);
+}
+
+waterfall_texture::~waterfall_texture()
+{
+    QOpenGLFunctions *gl = gl_functions();
+
+    if(gl&&m_texture_id)
+        gl->glDeleteTextures(1, &m_texture_id);
+}
+
+void waterfall_texture::upload(const QImage &image)
+{
+    QOpenGLFunctions *gl = gl_functions();
+
+    if((!gl)||image.isNull())
+        return;
+
+    if(!m_texture_id)
+        gl->glGenTextures(1, &m_texture_id);
+
+    gl->glBindTexture(GL_TEXTURE_2D, m_texture_id);
+
+    if(m_size != image.size())
+    {
+        m_size = image.size();
+        gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_size.width(), m_size.height(), 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, Q_NULLPTR);
+    }
+
+    upload_rows(image, 0, image.height());
+}
+
+void waterfall_texture::upload(const QImage &image, const int &first_row, const int &row_count)
+{
+    if((!m_texture_id)||(m_size != image.size()))
+    {
+        upload(image);
+        return;
+    }
+
+    QOpenGLFunctions *gl = gl_functions();
+
+    if(!gl)
+        return;
+
+    gl->glBindTexture(GL_TEXTURE_2D, m_texture_id);
+
+    // rows can wrap around the end of the ring
+    const int rows = image.height();
+    const int count = qMin(row_count, rows);
+    const int first_count = qMin(count, rows - first_row);
+
+    upload_rows(image, first_row, first_count);
+
+    if(count > first_count)
+        upload_rows(image, 0, count - first_count);
+}
+
+void waterfall_texture::upload_rows(const QImage &image, const int &first_row, const int &row_count)
+{
+    QOpenGLFunctions *gl = gl_functions();
+    const int width = image.width();
+
+    if((!gl)||(row_count <= 0))
+        return;
+
+    // GL_BGRA is not in OpenGL ES 2, rows are converted to RGBA bytes
+    m_rgba.resize(width*row_count);
+    quint32 *rgba = m_rgba.data();
+
+    for(int y=0; y<row_count; ++y)
+    {
+        const QRgb *line = reinterpret_cast<const QRgb*>(image.constScanLine(first_row + y));
+
+        for(int x=0; x<width; ++x)
+        {
+            const QRgb pixel = line[x];
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            rgba[x] = 0xff000000u|((pixel&0xffu) << 16)|(pixel&0xff00u)|((pixel >> 16)&0xffu);
+#else
+            rgba[x] = (pixel << 8)|0xffu;
+#endif
+        }
+
+        rgba += width;
+    }
+
+    gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first_row, width, row_count,
+                        GL_RGBA, GL_UNSIGNED_BYTE, m_rgba.constData());
+}
+
+int waterfall_texture::textureId() const
+{
+    return static_cast<int>(m_texture_id);
+}
+
+QSize waterfall_texture::textureSize() const
+{
+    return m_size;
+}
+
+bool waterfall_texture::hasAlphaChannel() const
+{
+    return false;
+}
+
+bool waterfall_texture::hasMipmaps() const
+{
+    return false;
+}
+
+void waterfall_texture::bind()
+{
+    QOpenGLFunctions *gl = gl_functions();
+
+    if(gl&&m_texture_id)
+    {
+        gl->glBindTexture(GL_TEXTURE_2D, m_texture_id);
+        updateBindOptions(true);
+    }
+}
+
+waterfall_node::waterfall_node()
+{
+    ptr_top = new QSGSimpleTextureNode;
+    ptr_bottom = new QSGSimpleTextureNode;
+
+    ptr_top->setFiltering(QSGTexture::Linear);
+    ptr_bottom->setFiltering(QSGTexture::Linear);
+
+    // texture is shared by both quads
+    ptr_top->setOwnsTexture(false);
+    ptr_bottom->setOwnsTexture(false);
+}
+
+waterfall_node::~waterfall_node()
+{
+    // quads are not in the tree without texture
+    if(!ptr_top->parent())
+        delete ptr_top;
+
+    if(!ptr_bottom->parent())
+        delete ptr_bottom;
+
+    delete ptr_texture;
+}
+
+void waterfall_node::set_texture(QSGTexture *texture)
+{
+    if(texture == ptr_texture)
+        return;
+
+    QSGTexture *old_texture = ptr_texture;
+    ptr_texture = texture;
+
+    if(ptr_texture)
+    {
+        ptr_top->setTexture(ptr_texture);
+        ptr_bottom->setTexture(ptr_texture);
+
+        if(!ptr_top->parent())
+        {
+            appendChildNode(ptr_top);
+            appendChildNode(ptr_bottom);
+        }
+    }
+
+    delete old_texture;
+}
+
+QSGTexture *waterfall_node::texture() const
+{
+    return ptr_texture;
+}
+
+void waterfall_node::set_geometry(const QRectF &target, const QSize &size, const int &write_row)
+{
+    if((!ptr_texture)||size.isEmpty())
+        return;
+
+    const int rows = size.height();
+    const int top_rows = rows - write_row;
+    const qreal scale_y = target.height()/rows;
+
+    ptr_top->setRect(QRectF(target.x(), target.y(), target.width(), top_rows*scale_y));
+    ptr_top->setSourceRect(QRectF(0, write_row, size.width(), top_rows));
+
+    ptr_bottom->setRect(QRectF(target.x(), target.y() + top_rows*scale_y, target.width(), write_row*scale_y));
+    ptr_bottom->setSourceRect(QRectF(0, 0, size.width(), write_row));
+
+    // content of the texture is updated in place
+    ptr_top->markDirty(QSGNode::DirtyMaterial);
+    ptr_bottom->markDirty(QSGNode::DirtyMaterial);
+}
+
+trace_node::trace_node() :
+    m_geometry(QSGGeometry::defaultAttributes_Point2D(), 0)
+{
+    m_geometry.setDrawingMode(QSGGeometry::DrawLineStrip);
+    m_geometry.setLineWidth(1);
+
+    setGeometry(&m_geometry);
+    setMaterial(&m_material);
+}
+
+void trace_node::set_color(const QColor &color)
+{
+    if(m_material.color() != color)
+    {
+        m_material.setColor(color);
+        markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+void trace_node::set_points(const QVector<QPointF> &points)
+{
+    // reallocated only when the number of points changes
+    if(m_geometry.vertexCount() != points.size())
+        m_geometry.allocate(points.size());
+
+    QSGGeometry::Point2D *vertex = m_geometry.vertexDataAsPoint2D();
+
+    for(int i=0; i<points.size(); ++i)
+        vertex[i].set(static_cast<float>(points.at(i).x()), static_cast<float>(points.at(i).y()));
+
+    markDirty(QSGNode::DirtyGeometry);
+}
+
+surface_node::surface_node(const bool &is_opengl) :
+    m_opengl(is_opengl)
+{
+    ptr_chrome = new QSGSimpleTextureNode;
+    ptr_chrome->setOwnsTexture(true);
+    ptr_labels = new QSGSimpleTextureNode;
+    ptr_labels->setOwnsTexture(true);
+    ptr_traces_image = new QSGSimpleTextureNode;
+    ptr_traces_image->setOwnsTexture(true);
+
+    ptr_waterfall = new waterfall_node;
+    ptr_traces = new QSGNode;
+
+    // chrome is inserted before the waterfall, labels are appended
+    // after the traces (scrollback time is drawn over the waterfall)
+    appendChildNode(ptr_waterfall);
+    appendChildNode(ptr_traces);
+}
+
+surface_node::~surface_node()
+{
+    if(!ptr_chrome->parent())
+        delete ptr_chrome;
+
+    if(!ptr_labels->parent())
+        delete ptr_labels;
+
+    if(!ptr_traces_image->parent())
+        delete ptr_traces_image;
+}
+
+void surface_node::set_chrome(QSGTexture *texture, const QRectF &rect)
+{
+    ptr_chrome->setTexture(texture);
+    ptr_chrome->setRect(rect);
+
+    if(!ptr_chrome->parent())
+        insertChildNodeBefore(ptr_chrome, ptr_waterfall);
+}
+
+void surface_node::set_labels(QSGTexture *texture, const QRectF &rect)
+{
+    ptr_labels->setTexture(texture);
+    ptr_labels->setRect(rect);
+
+    if(!ptr_labels->parent())
+        appendChildNode(ptr_labels);
+}
+
+void surface_node::set_traces_image(QSGTexture *texture, const QRectF &rect)
+{
+    ptr_traces_image->setTexture(texture);
+    ptr_traces_image->setRect(rect);
+
+    if(!ptr_traces_image->parent())
+        ptr_traces->appendChildNode(ptr_traces_image);
+}
@@ -0,0 +1,98 @@
+#ifndef SURFACE_NODES_H
+#define SURFACE_NODES_H
+
+#include <QMap>
+#include <QSGGeometryNode>
+#include <QSGSimpleTextureNode>
+#include <QSGFlatColorMaterial>
+#include <QSGTexture>
+#include <QtGui/qopengl.h>
+
+// waterfall ring image as an OpenGL texture: full upload on resize, then
+// only the rows written since the previous frame (glTexSubImage2D).
+// upload() is called from updatePaintNode (render thread, context current)
+class waterfall_texture : public QSGTexture
+{
+    Q_OBJECT
+public:
+    waterfall_texture();
+    ~waterfall_texture() Q_DECL_OVERRIDE;
+
+    void upload(const QImage &image);
+    void upload(const QImage &image, const int &first_row, const int &row_count);
+
+    int textureId()const Q_DECL_OVERRIDE;
+    QSize textureSize()const Q_DECL_OVERRIDE;
+    bool hasAlphaChannel()const Q_DECL_OVERRIDE;
+    bool hasMipmaps()const Q_DECL_OVERRIDE;
+    void bind() Q_DECL_OVERRIDE;
+
+private:
+    GLuint m_texture_id {0};
+    QSize m_size;
+    QVector<quint32> m_rgba;    // row conversion (RGB32 -> RGBA bytes)
+
+    void upload_rows(const QImage &image, const int &first_row, const int &row_count);
+};
+
+// ring image drawn as two textured quads, newest row on top:
+// rows [write_row, rows) then rows [0, write_row). The texture is owned
+class waterfall_node : public QSGNode
+{
+public:
+    waterfall_node();
+    ~waterfall_node() Q_DECL_OVERRIDE;
+
+    void set_texture(QSGTexture *);
+    QSGTexture *texture()const;
+
+    void set_geometry(const QRectF &target, const QSize &size, const int &write_row);
+
+private:
+    QSGTexture *ptr_texture {Q_NULLPTR};
+    QSGSimpleTextureNode *ptr_top {Q_NULLPTR};
+    QSGSimpleTextureNode *ptr_bottom {Q_NULLPTR};
+};
+
+// spectr trace as a line strip, vertex buffer is updated in place
+class trace_node : public QSGGeometryNode
+{
+public:
+    trace_node();
+
+    void set_color(const QColor &);
+    void set_points(const QVector<QPointF> &);
+
+private:
+    QSGGeometry m_geometry;
+    QSGFlatColorMaterial m_material;
+};
+
+// surface_spectr content: cached chrome (background, axes, grid), waterfall,
+// traces, cached labels on top. Without OpenGL (software backend) traces
+// are rasterized to "ptr_traces_image"
+class surface_node : public QSGNode
+{
+public:
+    explicit surface_node(const bool &is_opengl);
+    ~surface_node() Q_DECL_OVERRIDE;
+
+    bool is_opengl()const { return m_opengl; }
+
+    // textures are owned, a node is in the tree after its first texture
+    void set_chrome(QSGTexture *, const QRectF &);
+    void set_labels(QSGTexture *, const QRectF &);
+    void set_traces_image(QSGTexture *, const QRectF &);
+
+    waterfall_node *ptr_waterfall {Q_NULLPTR};
+    QSGNode *ptr_traces {Q_NULLPTR};
+    QMap<QString, trace_node*> m_traces;
+
+private:
+    bool m_opengl;
+    QSGSimpleTextureNode *ptr_chrome {Q_NULLPTR};
+    QSGSimpleTextureNode *ptr_labels {Q_NULLPTR};
+    QSGSimpleTextureNode *ptr_traces_image {Q_NULLPTR};
+};
+
+#endif // SURFACE_NODES_H
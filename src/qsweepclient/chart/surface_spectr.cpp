@@ -2,14 +2,45 @@
 
 #include <QtGui/QPainter>
 #include <cmath>
+#include <cstring>
 #include <QTimer>
 #include <QDateTime>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+#include <QStaticText>
+
+#include "surface_nodes.h"
 
 #ifdef QT_DEBUG
 #include <QtCore/qdebug.h>
 #endif
 
-surface_spectr::surface_spectr(QQuickItem *parent) : QQuickPaintedItem(parent)
+// waterfall row height of one sweep (pixels)
+static const int waterfall_row_height = 6;
+// zoom: span factor of one wheel step, narrowest span (part of the sweep)
+static const qreal zoom_step = 1.25;
+static const qreal zoom_span_min = 1e-6;
+// scrollback: sweeps of one wheel step
+static const qreal history_step = 3;
+
+// label layouts kept (QStaticText)
+static const int label_cache_size = 256;
+
+// spectr items of the traces, by trace_type
+struct trace_style
+{
+    const char *m_name;
+    Qt::GlobalColor m_color;
+};
+
+static const trace_style trace_styles[trace_count] = {
+    {"spectr_max", Qt::red},
+    {"spectr_min", Qt::blue},
+    {"spectr_average", Qt::yellow},
+    {"spectr_peak", Qt::magenta}
+};
+
+surface_spectr::surface_spectr(QQuickItem *parent) : QQuickItem(parent)
 {
     setAcceptHoverEvents(true);
     setAcceptedMouseButtons(Qt::AllButtons);
@@ -21,7 +52,8 @@ surface_spectr::surface_spectr(QQuickItem *parent) : QQuickPaintedItem(parent)
     m_grid_pen.setColor(Qt::darkGray);
     m_grid_pen.setStyle(Qt::DashLine);
 
-    is_spectr_max_calc = false;
+    m_label_font.setPointSizeF(10);
+
     m_ticket_segment = 4;
     m_ticket_segment_frequency = 7;
     m_ticket_segment_waterfall = 4;
@@ -45,40 +77,9 @@ surface_spectr::surface_spectr(QQuickItem *parent) : QQuickPaintedItem(parent)
     this->setVisible(true);
     this->setFlag(QQuickItem::ItemHasContents);
 
-    m_image_waterfall = QImage(waterfall_size().x(), waterfall_size().y(), QImage::Format_ARGB32);
-    m_image_waterfall.fill(m_color_background);
-    m_sensitivity_waterfall = 0.47; // 0.48 <-> 0.05;
-
-    // Generate displayable colors
-    QImage img(500, 1, QImage::Format_ARGB32);
-    m_colors_waterfall.reserve(img.height());
-
-    QPainter painter;
-    painter.begin(&img);
-    QLinearGradient gradient;
-    gradient.setStart(0, 0);
-    gradient.setFinalStop(img.width(), 0);
-
-//    gradient.setColorAt(0, QColor(255, 255, 255));
-//    gradient.setColorAt(0.2, QColor(0, 0, 255));
-//    gradient.setColorAt(0.4, QColor(255, 240, 0));
-//    gradient.setColorAt(0.6, QColor(255, 0, 0));
-//    gradient.setColorAt(1, QColor(0, 0, 0));
-
-    gradient.setColorAt(1, QColor(255, 255, 255));
-    gradient.setColorAt(0.6, QColor(0, 0, 255));
-    gradient.setColorAt(0.4, QColor(255, 240, 0));
-    gradient.setColorAt(0.2, QColor(255, 0, 0));
-    gradient.setColorAt(0, QColor(0, 0, 0));
-
-    gradient.setSpread(QGradient::PadSpread);
-    painter.fillRect(QRect(0, 0, img.width(), 1), QBrush(gradient));
-    painter.end();
-
-    for (int i = 0; i < img.width(); i++) {
-        QRgb rgb = img.pixel(i, 0);
-        m_colors_waterfall.append(rgb);
-    }
+    m_waterfall.resize(waterfall_size().x(), waterfall_rows());
+    m_waterfall.clear(m_color_background);
+    m_palette = palette_type::classic;
 
     connect(this, &QQuickItem::widthChanged,
             this, &surface_spectr::slot_size_changed);
@@ -87,9 +88,6 @@ surface_spectr::surface_spectr(QQuickItem *parent) : QQuickPaintedItem(parent)
 
     add_spectr_item("spectr_rt", Qt::green);
 
-    if(is_spectr_max_calc)
-        add_spectr_item("spectr_max", Qt::red);
-
     update();
 
     // for test
@@ -104,178 +102,325 @@ surface_spectr::surface_spectr(QQuickItem *parent) : QQuickPaintedItem(parent)
 
 }
 
-void surface_spectr::paint(QPainter *painter)
+surface_spectr::~surface_spectr()
 {
-    QBrush brush(m_color_background);
+    qDeleteAll(m_spectr_item_list);
+    m_spectr_item_list.clear();
+}
 
-    painter->setBrush(brush);
-    painter->drawRect(QRectF(0,0,this->width(),this->height()));
+void surface_spectr::updatePolish()
+{
+    // GUI thread, before the scene graph sync of the next frame
+    if(!m_frame_pending)
+        return;
 
-    // spectr surface
-    spectr_surface_paint(painter);
-    // waterfall surface
-    waterfall_surface_paint(painter);
+    m_frame_pending = false;
 
-    if(painter!= Q_NULLPTR)
-        painter->drawImage(QRect(waterfall_point().x()+1, waterfall_point().y()+1, waterfall_size().x()-1, waterfall_size().y()-1), m_image_waterfall, QRect(0, 0, m_image_waterfall.width(), m_image_waterfall.height()));
+    if(ptr_render_buffer.isNull()||(!ptr_render_buffer->take(m_front)))
+        return;
 
-    QMap<QString, spectr_item*>::const_iterator spectr_it;
+    // waterfall rows of every sweep since the previous frame, or all rows
+    // of the view rendered from the history
+    if(m_front.m_row_width == m_waterfall.width())
+    {
+        if(m_front.m_rows_reset)
+            m_waterfall.clear(m_color_background);
+
+        const QRgb *rows = m_front.m_rows.constData();
+        const size_t row_size = static_cast<size_t>(m_front.m_row_width)*sizeof(QRgb);
+
+        for(qint32 i=0; i<m_front.m_row_count; ++i)
+            std::memcpy(m_waterfall.next_row(), rows + i*m_front.m_row_width, row_size);
+    }
+
+    m_history_first = m_front.m_history_first;
+    m_history_last = m_front.m_history_last;
+
+    // frame of a previous viewport (resize): the traces of the current one follow
+    if(m_front.m_view_id != m_view.m_id)
+        return;
+
+    // time label of the scrollback
+    if(m_front.m_history_end_time != m_history_end_time)
+    {
+        m_history_end_time = m_front.m_history_end_time;
+        m_labels_dirty = true;
+    }
 
-    for(spectr_it = m_spectr_item_list.begin(); spectr_it != m_spectr_item_list.end(); spectr_it++)
+    // update min max freq (labels of the static layer), new range: zoom out
+    if((m_front.m_frequency_min != m_frequency_min)||(m_front.m_frequency_max != m_frequency_max))
     {
-        for(int j=0; j<spectr_it.value()->raw_data_size()-1; ++j)
+        m_frequency_min = m_front.m_frequency_min;
+        m_frequency_max = m_front.m_frequency_max;
+        m_labels_dirty = true;
+
+        if((m_view.m_span_low > 0)||(m_view.m_span_high < 1)||(m_view.m_history_end >= 0))
         {
-            painter->setPen(spectr_it.value()->item_pen());
-            painter->drawLine(spectr_it.value()->raw_data_pos(j), spectr_it.value()->raw_data_pos(j+1));
+            m_view.m_span_low = 0;
+            m_view.m_span_high = 1;
+            m_view.m_history_end = -1;
+
+            update_render_view();
+            update();
+            return;
         }
     }
 
-//#ifdef QT_DEBUG
-//    qDebug() << Q_FUNC_INFO << "-----------------------------------------";
-//    qDebug() << Q_FUNC_INFO << "waterfall_size:" << waterfall_size();
-//    qDebug() << Q_FUNC_INFO << "m_surface_point:" << m_surface_point;
-//    qDebug() << Q_FUNC_INFO << "level size:" << this->height()/2 - m_surface_point.y();
-//    qDebug() << Q_FUNC_INFO << "frequency size:" << this->width() - m_surface_point.x();
-//#endif
-}
+    m_spectr_item_list.value("spectr_rt")->set_raw_data(m_front.m_spectr_rt);
 
-qreal surface_spectr::sensitivity_waterfall() const
-{
-    return m_sensitivity_waterfall;
-}
+    for(int i=0; i<trace_count; ++i)
+        if(is_trace(static_cast<trace_type>(i)))
+            m_spectr_item_list.value(trace_styles[i].m_name)->set_raw_data(m_front.m_traces[i]);
 
-qreal surface_spectr::split_surface() const
-{
-    return m_split_surface;
+    if(!m_front.m_noise_floor.isEmpty())
+    {
+        add_spectr_item("noise_floor", Qt::gray);
+        m_spectr_item_list.value("noise_floor")->set_raw_data(m_front.m_noise_floor);
+    }
+
+    m_traces_dirty = true;
 }
 
-void surface_spectr::clear()
+void surface_spectr::slot_frame_ready()
 {
-    if(!m_image_waterfall.isNull())
-    {
-        m_image_waterfall = QImage(waterfall_size().x(), waterfall_size().y(), QImage::Format_ARGB32);
-        m_image_waterfall.fill(QColor(255, 255, 255));
-    }
+    // several frames between two vsyncs are taken once
+    m_frame_pending = true;
+
+    polish();
+    update();
 }
 
-qreal surface_spectr::level_min() const
+void surface_spectr::set_render_buffer(const QSharedPointer<render_buffer> &value)
 {
-    return m_level_min;
+    ptr_render_buffer = value;
+
+    update_render_view();
 }
 
-double surface_spectr::level_max() const
+void surface_spectr::update_render_view()
 {
-    return m_level_max;
+    m_view.m_id++;
+    m_view.m_area = spectr_area();
+    m_view.m_waterfall_width = m_waterfall.width();
+    m_view.m_waterfall_rows = m_waterfall.rows();
+    m_view.m_level_min = m_level_min;
+    m_view.m_level_max = m_level_max;
+    m_view.m_palette = m_palette;
+    m_view.m_traces = m_traces;
+
+    emit signal_render_view(m_view);
 }
 
-void surface_spectr::slot_power_spectr(const QDateTime &dt, const quint64 &freq_min, const quint64 &freq_max, const QVector<qreal> &spectr)
+QSGNode *surface_spectr::updatePaintNode(QSGNode *old_node, UpdatePaintNodeData *)
 {
-    Q_UNUSED(dt)
+    surface_node *node = static_cast<surface_node*>(old_node);
 
-    // update min max freq
-    if(freq_min != m_frequency_min)
-        m_frequency_min = freq_min;
+    if(!node)
+    {
+        const QSGRendererInterface *renderer = window()->rendererInterface();
+        node = new surface_node(renderer&&(renderer->graphicsApi() == QSGRendererInterface::OpenGL));
 
-    if(freq_max != m_frequency_max)
-        m_frequency_max = freq_max;
+        m_chrome_dirty = true;
+        m_labels_dirty = true;
+        m_traces_dirty = true;
+        m_waterfall.set_dirty();
+    }
 
-//#ifdef QT_DEBUG
-//    qDebug() << Q_FUNC_INFO << "dt" << dt.toLocalTime();
-//#endif
+    if((width() <= 0)||(height() <= 0))
+        return node;
 
-    spectr_rt_vector.clear();
-    spectr_rt_vector.reserve(spectr.size());
+    // static layers: frame only on resize, labels on level, frequency,
+    // zoom and scrollback change
+    if(m_chrome_dirty)
+    {
+        node->set_chrome(window()->createTextureFromImage(chrome_image()), boundingRect());
+        m_chrome_dirty = false;
+    }
 
-    if(is_spectr_max_calc)
+    if(m_labels_dirty)
     {
-        spectr_max_vector.clear();
-        spectr_max_vector.reserve(spectr.size());
+        node->set_labels(window()->createTextureFromImage(labels_image()), boundingRect());
+        m_labels_dirty = false;
+    }
 
-        if(spectr_max_value.size() != spectr.size())
+    // waterfall: rows written since the previous frame
+    if(!m_waterfall.is_null())
+    {
+        const QImage &image = m_waterfall.image();
+
+        if(node->is_opengl())
         {
-            spectr_max_value.clear();
-            spectr_max_value.reserve(spectr.size());
-            spectr_max_value.append(spectr);
+            waterfall_texture *texture = static_cast<waterfall_texture*>(node->ptr_waterfall->texture());
+
+            if(!texture)
+            {
+                texture = new waterfall_texture;
+                node->ptr_waterfall->set_texture(texture);
+                m_waterfall.set_dirty();
+            }
+
+            if(m_waterfall.dirty_rows() < 0)
+                texture->upload(image);
+            else if(m_waterfall.dirty_rows() > 0)
+                texture->upload(image, m_waterfall.write_row(), m_waterfall.dirty_rows());
+        }else if(m_waterfall.dirty_rows() != 0){
+            node->ptr_waterfall->set_texture(window()->createTextureFromImage(image));
         }
-    }
 
-    qreal range = 0;
-    qreal shift_x = static_cast<qreal>(m_surface_point.x()+1);
-    qreal shift_y = static_cast<qreal>((this->height()/2 - m_surface_point.y())/100);
+        m_waterfall.reset_dirty();
+
+        node->ptr_waterfall->set_geometry(QRectF(waterfall_point().x()+1, waterfall_point().y()+1,
+                                                 waterfall_size().x()-1, waterfall_size().y()-1),
+                                          image.size(), m_waterfall.write_row());
+    }
 
-    for(int i=0; i<spectr.size(); ++i)
+    // traces
+    if(m_traces_dirty)
     {
-        qreal level = spectr.at(i);
+        if(node->is_opengl())
+        {
+            // remove nodes of removed items
+            for(auto it = node->m_traces.begin(); it != node->m_traces.end();)
+            {
+                if(!m_spectr_item_list.contains(it.key()))
+                {
+                    node->ptr_traces->removeChildNode(it.value());
+                    delete it.value();
+                    it = node->m_traces.erase(it);
+                }else{
+                    ++it;
+                }
+            }
+
+            QMap<QString, spectr_item*>::const_iterator spectr_it;
+
+            for(spectr_it = m_spectr_item_list.constBegin(); spectr_it != m_spectr_item_list.constEnd(); ++spectr_it)
+            {
+                trace_node *trace = node->m_traces.value(spectr_it.key(), Q_NULLPTR);
+
+                if(!trace)
+                {
+                    trace = new trace_node;
+                    node->ptr_traces->appendChildNode(trace);
+                    node->m_traces.insert(spectr_it.key(), trace);
+                }
+
+                trace->set_color(spectr_it.value()->item_color());
+                trace->set_points(spectr_it.value()->raw_data());
+            }
+        }else{
+            node->set_traces_image(window()->createTextureFromImage(traces_image()), boundingRect());
+        }
 
-        if(level > m_level_max)
-            level = m_level_max;
+        m_traces_dirty = false;
+    }
 
-        if(level < m_level_min)
-            level = m_level_min;
+    return node;
+}
 
-        if(is_spectr_max_calc)
-            if(level > spectr_max_value.at(i))
-                spectr_max_value[i] = level;
+QImage surface_spectr::chrome_image()
+{
+    const qreal dpr = window() ? window()->effectiveDevicePixelRatio() : 1;
 
-        qreal x = shift_x + range;
-        qreal y = std::abs(shift_y * level) + m_surface_point.y()-1;
+    QImage image(static_cast<int>(width()*dpr), static_cast<int>(height()*dpr), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(m_color_background);
 
-        const QPointF tmp(x, y);
-        spectr_rt_vector.append(tmp);
+    QPainter painter;
+    painter.begin(&image);
 
-        if(is_spectr_max_calc)
-        {
-            qreal y_max = std::abs(shift_y * spectr_max_value.at(i)) + m_surface_point.y()-1;
-            const QPointF tmp_max(x, y_max);
-            spectr_max_vector.append(tmp_max);
-        }
+    // spectr surface
+    spectr_surface_paint(&painter);
+    // waterfall surface
+    waterfall_surface_paint(&painter);
 
-        range += (this->width()-m_surface_point.x()*2-1)/spectr.size();
-    }
+    painter.end();
 
-    m_spectr_item_list.value("spectr_rt")->set_raw_data(spectr_rt_vector);
+    return image;
+}
 
-    if(is_spectr_max_calc)
-        m_spectr_item_list.value("spectr_max")->set_raw_data(spectr_max_vector);
+QImage surface_spectr::labels_image()
+{
+    const qreal dpr = window() ? window()->effectiveDevicePixelRatio() : 1;
 
-    // waterfall
-    QImage img(waterfall_size().x(), waterfall_size().y(), QImage::Format_ARGB32);
+    QImage image(static_cast<int>(width()*dpr), static_cast<int>(height()*dpr), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
 
     QPainter painter;
-    painter.begin(&img);
+    painter.begin(&image);
+    painter.setFont(m_label_font);
 
-    // Draw 1st pixel row: new values
-    for (int x = 0; x < img.width(); x++)
-    {
-        int i1 = static_cast<int>(x * spectr.size() / img.width());
-        qreal amplitude = std::log10(std::abs(spectr.at(i1)));
-        int value = static_cast<int>(amplitude * static_cast<qreal>(m_sensitivity_waterfall) * static_cast<qreal>(m_colors_waterfall.length()));
+    spectr_labels_paint(&painter);
+    waterfall_labels_paint(&painter);
 
-        if (value < 0)
-            value = 0;
-        if (value >= m_colors_waterfall.length())
-            value = m_colors_waterfall.length() - 1;
+    painter.end();
 
-        painter.setPen(m_colors_waterfall.at(value));
-        painter.drawRect(x, 0, 1, 5);
-    }
+    return image;
+}
+
+QImage surface_spectr::traces_image() const
+{
+    const qreal dpr = window() ? window()->effectiveDevicePixelRatio() : 1;
 
-    // Draw old values
-    if (!m_image_waterfall.isNull()) {
-        painter.drawImage(QRect(0, 6, waterfall_size().x(), waterfall_size().y()), m_image_waterfall, QRect(0, 0, m_image_waterfall.width(), m_image_waterfall.height()));
+    QImage image(static_cast<int>(width()*dpr), static_cast<int>(height()*dpr), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+
+    QPainter painter;
+    painter.begin(&image);
+
+    QMap<QString, spectr_item*>::const_iterator spectr_it;
+
+    for(spectr_it = m_spectr_item_list.constBegin(); spectr_it != m_spectr_item_list.constEnd(); ++spectr_it)
+    {
+        const QVector<QPointF> points(spectr_it.value()->raw_data());
+
+        painter.setPen(spectr_it.value()->item_pen());
+        painter.drawPolyline(points.constData(), points.size());
     }
 
     painter.end();
 
-    // Redraw the item
-    m_image_waterfall = img;
+    return image;
+}
+
+qreal surface_spectr::split_surface() const
+{
+    return m_split_surface;
+}
+
+void surface_spectr::clear()
+{
+    m_waterfall.clear(QColor(255, 255, 255));
 
     update();
 }
 
-void surface_spectr::slot_sensitivity_waterfall(const qreal &value)
+qreal surface_spectr::level_min() const
+{
+    return m_level_min;
+}
+
+double surface_spectr::level_max() const
 {
-    m_sensitivity_waterfall = value;
+    return m_level_max;
+}
+
+int surface_spectr::palette() const
+{
+    return static_cast<int>(m_palette);
+}
+
+void surface_spectr::slot_palette(const int &value)
+{
+    if(value == palette())
+        return;
+
+    m_palette = static_cast<palette_type>(value);
+    update_render_view();
+
+    emit signal_palette_changed();
 }
 
 void surface_spectr::slot_split_surface(const qreal &value)
@@ -285,17 +430,83 @@ void surface_spectr::slot_split_surface(const qreal &value)
 
 void surface_spectr::slot_spectr_max_calc(const bool &value)
 {
-    is_spectr_max_calc = value;
+    set_trace(trace_type::max_hold, value);
+}
+
+bool surface_spectr::max_hold() const
+{
+    return is_trace(trace_type::max_hold);
+}
+
+bool surface_spectr::min_hold() const
+{
+    return is_trace(trace_type::min_hold);
+}
+
+bool surface_spectr::average() const
+{
+    return is_trace(trace_type::average);
+}
 
-    if(is_spectr_max_calc)
-        add_spectr_item("spectr_max", Qt::red);
-    else
-        remove_spectr_item("spectr_max");
+bool surface_spectr::peak_decay() const
+{
+    return is_trace(trace_type::peak_decay);
+}
+
+void surface_spectr::slot_max_hold(const bool &value)
+{
+    set_trace(trace_type::max_hold, value);
+}
+
+void surface_spectr::slot_min_hold(const bool &value)
+{
+    set_trace(trace_type::min_hold, value);
+}
+
+void surface_spectr::slot_average(const bool &value)
+{
+    set_trace(trace_type::average, value);
+}
+
+void surface_spectr::slot_peak_decay(const bool &value)
+{
+    set_trace(trace_type::peak_decay, value);
+}
+
+bool surface_spectr::is_trace(const trace_type &type) const
+{
+    return m_traces & (1u << static_cast<int>(type));
+}
+
+void surface_spectr::set_trace(const trace_type &type, const bool &value)
+{
+    if(value == is_trace(type))
+        return;
+
+    const trace_style &style = trace_styles[static_cast<int>(type)];
+
+    if(value)
+    {
+        m_traces |= (1u << static_cast<int>(type));
+        add_spectr_item(style.m_name, style.m_color);
+    }else{
+        m_traces &= ~(1u << static_cast<int>(type));
+        remove_spectr_item(style.m_name);
+    }
+
+    m_traces_dirty = true;
+    update_render_view();
+    update();
+
+    emit signal_traces_changed();
 }
 
 void surface_spectr::slot_level_min(const qreal &value)
 {
     m_level_min = value;
+    m_labels_dirty = true;
+    update_render_view();
+    update();
 
     emit signal_level_min_changed();
 }
@@ -303,6 +514,9 @@ void surface_spectr::slot_level_min(const qreal &value)
 void surface_spectr::slot_level_max(const qreal &value)
 {
     m_level_max = value;
+    m_labels_dirty = true;
+    update_render_view();
+    update();
 
     emit signal_level_max_changed();
 }
@@ -339,48 +553,163 @@ void surface_spectr::add_spectr_item(const QString &name, const QColor &color)
 
 void surface_spectr::remove_spectr_item(const QString &name)
 {
-    if(m_spectr_item_list.contains(name))
-    {
-        m_spectr_item_list.remove(name);
-        spectr_max_value.clear();
-        spectr_max_vector.clear();
-    }
+    delete m_spectr_item_list.take(name);
 }
 
 void surface_spectr::mousePressEvent(QMouseEvent *event)
 {
+    // pan start
+    if(event->button() == Qt::LeftButton)
+    {
+        m_pan_x = event->localPos().x();
+        event->accept();
+        return;
+    }
+
     QQuickItem::mousePressEvent(event);
-    qDebug() << Q_FUNC_INFO  << event->pos();
 }
 
-void surface_spectr::hoverMoveEvent(QHoverEvent *event)
+void surface_spectr::mouseMoveEvent(QMouseEvent *event)
 {
-    QQuickItem::hoverMoveEvent(event);
-    qDebug() << Q_FUNC_INFO  << event->pos();
+    // pan: the sweep follows the cursor
+    if(event->buttons() & Qt::LeftButton)
+    {
+        const qreal dx = event->localPos().x() - m_pan_x;
+        m_pan_x = event->localPos().x();
+
+        const qreal width = spectr_area().width();
+
+        if(width > 0)
+            set_span(m_view.m_span_low - dx/width*(m_view.m_span_high - m_view.m_span_low),
+                     m_view.m_span_high - dx/width*(m_view.m_span_high - m_view.m_span_low));
+
+        event->accept();
+        return;
+    }
+
+    QQuickItem::mouseMoveEvent(event);
 }
 
-void surface_spectr::slot_size_changed()
+void surface_spectr::mouseDoubleClickEvent(QMouseEvent *event)
 {
-    if(!m_image_waterfall.isNull())
+    // whole sweep range, live waterfall
+    set_history_end(-1);
+    set_span(0, 1);
+    event->accept();
+}
+
+void surface_spectr::wheelEvent(QWheelEvent *event)
+{
+    // waterfall: scrollback in time (wheel up: older sweeps)
+    if(event->position().y() >= waterfall_point().y())
     {
-        QImage img = QImage(waterfall_size().x(), waterfall_size().y(), QImage::Format_ARGB32);
-        img.fill(m_color_background);
+        const qint64 end = m_view.m_history_end < 0 ? m_history_last : m_view.m_history_end;
+        const qint64 step = static_cast<qint64>(std::lround(event->angleDelta().y()/120.0*history_step));
 
-        QPainter painter;
-        painter.begin(&img);
-        painter.drawImage(QRect(waterfall_point().x(), waterfall_point().y(), waterfall_size().x(), waterfall_size().y()), m_image_waterfall, QRect(0, 0, m_image_waterfall.width(), m_image_waterfall.height()));
-        painter.end();
+        if(end - step >= m_history_last)
+            set_history_end(-1);
+        else
+            set_history_end(qMax(qMin(m_history_first + m_waterfall.rows() - 1, m_history_last), end - step));
+
+        event->accept();
+        return;
+    }
 
-        m_image_waterfall = img;
+    const QRectF area = spectr_area();
 
-        update();
+    if(area.width() <= 0)
+    {
+        QQuickItem::wheelEvent(event);
+        return;
     }
 
-    m_spectr_item_list.value("spectr_rt")->clear_data();
+    // zoom around the frequency under the cursor
+    const qreal span = m_view.m_span_high - m_view.m_span_low;
+    const qreal cursor = qBound(0.0, (event->position().x() - area.left())/area.width(), 1.0);
+    const qreal center = m_view.m_span_low + cursor*span;
+    const qreal factor = std::pow(zoom_step, -event->angleDelta().y()/120.0);
+    const qreal new_span = qBound(zoom_span_min, span*factor, 1.0);
+
+    set_span(center - cursor*new_span, center + (1 - cursor)*new_span);
+
+    event->accept();
+}
+
+void surface_spectr::hoverMoveEvent(QHoverEvent *event)
+{
+    QQuickItem::hoverMoveEvent(event);
+
+    const QPoint point = event->pos();
+
+    set_cursor_point(spectr_area().contains(point) ? point : QPoint(-1, -1));
+}
+
+void surface_spectr::hoverLeaveEvent(QHoverEvent *event)
+{
+    QQuickItem::hoverLeaveEvent(event);
+
+    set_cursor_point(QPoint(-1, -1));
+}
+
+void surface_spectr::set_cursor_point(const QPoint &value)
+{
+    if(value == m_cursor_point)
+        return;
+
+    m_cursor_point = value;
+
+    // readout is drawn with the labels
+    m_labels_dirty = true;
+    update();
+}
+
+void surface_spectr::set_span(const qreal &low, const qreal &high)
+{
+    // keeps the width of the span inside [0, 1]
+    const qreal span = qBound(zoom_span_min, high - low, 1.0);
+    const qreal span_low = qBound(0.0, low, 1.0 - span);
+
+    if(qFuzzyCompare(span_low, m_view.m_span_low)&&qFuzzyCompare(span_low + span, m_view.m_span_high))
+        return;
+
+    m_view.m_span_low = span_low;
+    m_view.m_span_high = span_low + span;
+
+    m_labels_dirty = true;
+    update_render_view();
+    update();
+}
+
+void surface_spectr::set_history_end(const qint64 &value)
+{
+    if((value == m_view.m_history_end)||(m_history_last < 0))
+        return;
+
+    m_view.m_history_end = value;
+
+    update_render_view();
+    update();
+}
+
+qreal surface_spectr::view_frequency_min() const
+{
+    return m_frequency_min + m_view.m_span_low*(static_cast<qreal>(m_frequency_max) - m_frequency_min);
+}
+
+qreal surface_spectr::view_frequency_max() const
+{
+    return m_frequency_min + m_view.m_span_high*(static_cast<qreal>(m_frequency_max) - m_frequency_min);
+}
 
-    if(is_spectr_max_calc)
-        m_spectr_item_list.value("spectr_max")->clear_data();
+void surface_spectr::slot_size_changed()
+{
+    // rows are kept (scaled to the new size)
+    m_waterfall.resize(waterfall_size().x(), waterfall_rows());
+    m_chrome_dirty = true;
+    m_labels_dirty = true;
 
+    // traces of the latest sweep in the new area (ta_spectr)
+    update_render_view();
     update();
 }
 
@@ -394,10 +723,14 @@ QPoint surface_spectr::spectr_size() const
     return size;
 }
 
-void surface_spectr::spectr_surface_paint(QPainter *painter)
+QRectF surface_spectr::spectr_area() const
 {
-    // const auto rect = contentsBoundingRect(); rect.width(), rect.height()
+    return QRectF(m_surface_point.x()+1, m_surface_point.y(),
+                  spectr_size().x()-2, spectr_size().y());
+}
 
+void surface_spectr::spectr_surface_paint(QPainter *painter)
+{
     painter->setPen(m_color_axis);
 
     const QPolygon spectr_polygon({m_surface_point,
@@ -408,100 +741,112 @@ void surface_spectr::spectr_surface_paint(QPainter *painter)
 
     painter->drawPolygon(spectr_polygon);
 
-    // font
-    QFont font = painter->font();
-    font.setPointSizeF(10);
-    painter->setFont(font);
-
-    QFontMetrics font_metrics(painter->font());
-    int max_text_height = font_metrics.ascent()/2;
-
     //*******************************************************************************
     // level scale
-    // min ticket
-    QLine min_line(QPoint(m_surface_point.x()-5, spectr_size().y() + m_surface_point.y()),
-                   QPoint(m_surface_point.x(), spectr_size().y() + m_surface_point.y()));
-    painter->drawLine(min_line);
-    const QString min_text = QString::number(m_level_min);
-    int min_text_width = font_metrics.boundingRect(min_text).width()+5;
-    painter->drawText(QPoint(m_surface_point.x()-5-min_text_width, static_cast<int>(this->height()/2+max_text_height)), min_text);
-
-    // max ticket
-    QLine max_line(QPoint(m_surface_point.x()-5, m_surface_point.y()), m_surface_point);
-    painter->drawLine(max_line);
-    const QString max_text = QString::number(m_level_max);
-    int max_text_width = font_metrics.boundingRect(max_text).width()+5;
-    painter->drawText(QPoint(m_surface_point.x()-5-max_text_width, m_surface_point.y()+max_text_height), max_text);
+    // min, max ticket
+    painter->drawLine(QLine(QPoint(m_surface_point.x()-5, spectr_size().y() + m_surface_point.y()),
+                            QPoint(m_surface_point.x(), spectr_size().y() + m_surface_point.y())));
+    painter->drawLine(QLine(QPoint(m_surface_point.x()-5, m_surface_point.y()), m_surface_point));
 
     qreal step_y = spectr_size().y()/m_ticket_segment;
-    qreal step_level = std::abs(m_level_max - m_level_min)/m_ticket_segment;
 
     for(int i=1; i<m_ticket_segment; ++i)
     {
         painter->setPen(m_color_axis);
         int y = static_cast<int>(m_surface_point.y()+step_y*i);
         // ticked
-        QLine line(QPoint(m_surface_point.x()-5, y),
-                   QPoint(m_surface_point.x(), y));
-        painter->drawLine(line);
-        // text ticked
-        const QString text = QString::number(step_level*i*-1);
-        int text_width = font_metrics.boundingRect(text).width()+5;
-        painter->drawText(QPoint(m_surface_point.x()-5-text_width, y + max_text_height), text);
+        painter->drawLine(QLine(QPoint(m_surface_point.x()-5, y),
+                                QPoint(m_surface_point.x(), y)));
 
         // grid line
-        QLine grid_line(QPoint(m_surface_point.x()+1, y),
-                   QPoint(spectr_size().x()+m_surface_point.x()-1, y));
         painter->setPen(m_grid_pen);
-        painter->drawLine(grid_line);
+        painter->drawLine(QLine(QPoint(m_surface_point.x()+1, y),
+                                QPoint(spectr_size().x()+m_surface_point.x()-1, y)));
     }
 
     //*******************************************************************************
     // freq scale
-    // min freq ticket
-    QLine freq_min_line(QPoint(m_surface_point.x(), spectr_size().y() + m_surface_point.y() + 5),
-                   QPoint(m_surface_point.x(), spectr_size().y() + m_surface_point.y()));
+    // min, max freq ticket
     painter->setPen(m_ticket_pen);
-    painter->drawLine(freq_min_line);
-    // lebel
-    const QString min_freq_text = QString::number(static_cast<double>(m_frequency_min/1e6),'f', 1);
-    int min_freq_text_width = font_metrics.boundingRect(min_freq_text).height()+5;
-    painter->drawText(QPoint(m_surface_point.x(),  spectr_size().y()+m_surface_point.y()+min_freq_text_width), min_freq_text);
-
-    // max freq ticket
-    QLine freq_max_line(QPoint(m_surface_point.x() + spectr_size().x(), spectr_size().y() + m_surface_point.y() + 5),
-                   QPoint(m_surface_point.x()+ spectr_size().x(), spectr_size().y() + m_surface_point.y()));
-    painter->setPen(m_ticket_pen);
-    painter->drawLine(freq_max_line);
-
-    // lebel
-    const QString max_freq_text = QString::number(static_cast<double>(m_frequency_max/1e6),'f', 1);
-    int max_freq_text_height = font_metrics.boundingRect(max_freq_text).height()+5;
-    int max_freq_text_width = font_metrics.boundingRect(max_freq_text).width();
-    painter->drawText(QPoint( spectr_size().x() + m_surface_point.x() - max_freq_text_width, spectr_size().y()+m_surface_point.y()+max_freq_text_height), max_freq_text);
+    painter->drawLine(QLine(QPoint(m_surface_point.x(), spectr_size().y() + m_surface_point.y() + 5),
+                            QPoint(m_surface_point.x(), spectr_size().y() + m_surface_point.y())));
+    painter->drawLine(QLine(QPoint(m_surface_point.x() + spectr_size().x(), spectr_size().y() + m_surface_point.y() + 5),
+                            QPoint(m_surface_point.x()+ spectr_size().x(), spectr_size().y() + m_surface_point.y())));
 
     qreal step_x = spectr_size().x()/m_ticket_segment_frequency;
-    qreal step_freq = ((m_frequency_max - m_frequency_min)/static_cast<quint32>(m_ticket_segment_frequency))/1e6;
 
     for(int i=1; i<m_ticket_segment_frequency; ++i)
     {
         int x = static_cast<int>(m_surface_point.x() + step_x * i);
 
-        // text ticked
-        const QString text = QString::number(static_cast<double>((m_frequency_min/1e6)+step_freq*i), 'f', 1);
-        int text_width = font_metrics.boundingRect(text).width();
-        int text_height = font_metrics.boundingRect(text).height()+5;
-        painter->setPen(m_ticket_pen);
-        painter->drawText(QPoint(x-(text_width/2), spectr_size().y()+m_surface_point.y()+text_height), text);
-
         // grid line
-        QLine grid_line(QPoint(x, m_surface_point.y() + 1),
-                        QPoint(x, spectr_size().y() + m_surface_point.y() - 1));
         painter->setPen(m_grid_pen);
-        painter->drawLine(grid_line);
+        painter->drawLine(QLine(QPoint(x, m_surface_point.y() + 1),
+                                QPoint(x, spectr_size().y() + m_surface_point.y() - 1)));
     }
 }
 
+void surface_spectr::spectr_labels_paint(QPainter *painter)
+{
+    painter->setPen(m_ticket_pen);
+
+    const QFontMetrics font_metrics(m_label_font);
+    const int max_text_height = font_metrics.ascent()/2;
+    const int text_height = font_metrics.height()+5;
+
+    //*******************************************************************************
+    // level scale
+    draw_label(painter, QPoint(m_surface_point.x()-10, static_cast<int>(this->height()/2+max_text_height)),
+               QString::number(m_level_min), Qt::AlignRight);
+    draw_label(painter, QPoint(m_surface_point.x()-10, m_surface_point.y()+max_text_height),
+               QString::number(m_level_max), Qt::AlignRight);
+
+    qreal step_y = spectr_size().y()/m_ticket_segment;
+    qreal step_level = std::abs(m_level_max - m_level_min)/m_ticket_segment;
+
+    for(int i=1; i<m_ticket_segment; ++i)
+    {
+        int y = static_cast<int>(m_surface_point.y()+step_y*i);
+
+        draw_label(painter, QPoint(m_surface_point.x()-10, y + max_text_height),
+                   QString::number(step_level*i*-1), Qt::AlignRight);
+    }
+
+    //*******************************************************************************
+    // freq scale (zoom span)
+    const qreal view_min = view_frequency_min();
+    const qreal view_max = view_frequency_max();
+    const int precision = (view_max - view_min) < 10e6 ? 3 : 1;
+    const int y = spectr_size().y()+m_surface_point.y()+text_height;
+
+    draw_label(painter, QPoint(m_surface_point.x(), y), QString::number(view_min/1e6, 'f', precision), Qt::AlignLeft);
+    draw_label(painter, QPoint(spectr_size().x() + m_surface_point.x(), y), QString::number(view_max/1e6, 'f', precision), Qt::AlignRight);
+
+    qreal step_x = spectr_size().x()/m_ticket_segment_frequency;
+    qreal step_freq = ((view_max - view_min)/m_ticket_segment_frequency)/1e6;
+
+    for(int i=1; i<m_ticket_segment_frequency; ++i)
+    {
+        int x = static_cast<int>(m_surface_point.x() + step_x * i);
+
+        draw_label(painter, QPoint(x, y), QString::number((view_min/1e6)+step_freq*i, 'f', precision), Qt::AlignHCenter);
+    }
+
+    //*******************************************************************************
+    // readout under the cursor: frequency of the zoom span, level of the scale
+    const QRectF area = spectr_area();
+
+    if((m_cursor_point.x() < 0)||(area.width() <= 0)||(area.height() <= 0))
+        return;
+
+    const qreal frequency = view_min + (m_cursor_point.x() - area.left())/area.width()*(view_max - view_min);
+    const qreal level = m_level_max - (m_cursor_point.y() - area.top())/area.height()*(m_level_max - m_level_min);
+
+    draw_label(painter, QPoint(static_cast<int>(area.right()) - 5, static_cast<int>(area.top()) + font_metrics.ascent() + 2),
+               QString("%1 MHz  %2 dB").arg(frequency/1e6, 0, 'f', precision + 3).arg(level, 0, 'f', 1),
+               Qt::AlignRight);
+}
+
 QPoint surface_spectr::waterfall_size() const
 {
     QPoint size;
@@ -522,6 +867,11 @@ QPoint surface_spectr::waterfall_point() const
     return point;
 }
 
+int surface_spectr::waterfall_rows() const
+{
+    return waterfall_size().y()/waterfall_row_height;
+}
+
 void surface_spectr::waterfall_surface_paint(QPainter *painter)
 {
     painter->setPen(m_color_axis);
@@ -555,3 +905,45 @@ void surface_spectr::waterfall_surface_paint(QPainter *painter)
         painter->drawLine(line);
     }
 }
+
+void surface_spectr::waterfall_labels_paint(QPainter *painter)
+{
+    // scrollback: time of the newest row
+    if((m_view.m_history_end < 0)||(!m_history_end_time.isValid()))
+        return;
+
+    painter->setPen(m_color_axis);
+
+    const QFontMetrics font_metrics(m_label_font);
+
+    draw_label(painter, QPoint(waterfall_point().x() + 5, waterfall_point().y() + font_metrics.ascent() + 2),
+               m_history_end_time.toLocalTime().toString("hh:mm:ss"), Qt::AlignLeft);
+}
+
+void surface_spectr::draw_label(QPainter *painter, const QPoint &baseline, const QString &text, const Qt::Alignment &align)
+{
+    // text layouts are kept between label updates
+    if(m_label_cache.size() > label_cache_size)
+        m_label_cache.clear();
+
+    QHash<QString, QStaticText>::iterator it = m_label_cache.find(text);
+
+    if(it == m_label_cache.end())
+    {
+        QStaticText static_text(text);
+        static_text.setTextFormat(Qt::PlainText);
+        static_text.prepare(painter->transform(), m_label_font);
+
+        it = m_label_cache.insert(text, static_text);
+    }
+
+    const QSizeF size = it.value().size();
+    QPointF top_left(baseline.x(), baseline.y() - QFontMetricsF(m_label_font).ascent());
+
+    if(align & Qt::AlignRight)
+        top_left.rx() -= size.width();
+    else if(align & Qt::AlignHCenter)
+        top_left.rx() -= size.width()/2;
+
+    painter->drawStaticText(top_left, it.value());
+}
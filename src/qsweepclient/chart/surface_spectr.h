@@ -1,24 +1,43 @@
 #ifndef SURFACE_SPECTR_H
 #define SURFACE_SPECTR_H
 
-#include <QQuickPaintedItem>
+#include <QQuickItem>
 #include <QImage>
+#include <QSharedPointer>
+#include <QStaticText>
+#include <QFont>
 #include <QRandomGenerator>
 
 #include "spectr_item.h"
+#include "waterfall_buffer.h"
+#include "spectr/render_frame.h"
 #include "template/ranges_template.h"
 
-class surface_spectr : public QQuickPaintedItem
+// spectr and waterfall on the scene graph (see surface_nodes.h)
+class surface_spectr : public QQuickItem
 {
     Q_OBJECT
     Q_PROPERTY(qreal level_min READ level_min WRITE slot_level_min NOTIFY signal_level_min_changed)
     Q_PROPERTY(qreal level_max READ level_max WRITE slot_level_max NOTIFY signal_level_max_changed)
+    // waterfall palette (palette_type: 0 classic, 1 viridis, 2 inferno, 3 turbo)
+    Q_PROPERTY(int palette READ palette WRITE slot_palette NOTIFY signal_palette_changed)
+    // traces (ta_spectr trace_engine)
+    Q_PROPERTY(bool max_hold READ max_hold WRITE slot_max_hold NOTIFY signal_traces_changed)
+    Q_PROPERTY(bool min_hold READ min_hold WRITE slot_min_hold NOTIFY signal_traces_changed)
+    Q_PROPERTY(bool average READ average WRITE slot_average NOTIFY signal_traces_changed)
+    Q_PROPERTY(bool peak_decay READ peak_decay WRITE slot_peak_decay NOTIFY signal_traces_changed)
 
 public:
     explicit surface_spectr(QQuickItem *parent = Q_NULLPTR);
-    void paint(QPainter *painter) override;
+    ~surface_spectr();
 
-    qreal sensitivity_waterfall() const;
+    int palette()const;
+
+    // traces
+    bool max_hold()const;
+    bool min_hold()const;
+    bool average()const;
+    bool peak_decay()const;
     qreal split_surface()const;
 
     void clear();
@@ -27,20 +46,36 @@ public:
     qreal level_min()const;
     qreal level_max()const;
 
+    // frames of ta_spectr (render prep worker), then sends the current view
+    void set_render_buffer(const QSharedPointer<render_buffer> &);
+
     void add_spectr_item(const QString &, const QColor &color);
     void remove_spectr_item(const QString &);
 
+    // zoom (wheel) and pan (drag) over frequency, wheel over the waterfall:
+    // scrollback in time, double click: whole range and live waterfall
     void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    // frequency and level readout under the cursor (spectr area)
     void hoverMoveEvent(QHoverEvent* event) override;
+    void hoverLeaveEvent(QHoverEvent* event) override;
 
 public slots:
-    void slot_power_spectr(const QDateTime &, const quint64 &, const quint64 &, const QVector<qreal> &spectr);
-    void slot_sensitivity_waterfall(const qreal &);
+    // new frame in the render buffer
+    void slot_frame_ready();
+    void slot_palette(const int &);
     void slot_split_surface(const qreal &);
 
-    // view max spectr
+    // view max spectr (max hold)
     void slot_spectr_max_calc(const bool &);
 
+    void slot_max_hold(const bool &);
+    void slot_min_hold(const bool &);
+    void slot_average(const bool &);
+    void slot_peak_decay(const bool &);
+
     // level
     void slot_level_min(const qreal &);
     void slot_level_max(const qreal &);
@@ -51,10 +86,19 @@ public slots:
     // for test
     void slot_power_spectr_test();
 
+protected:
+    void updatePolish() override;
+    QSGNode *updatePaintNode(QSGNode *, UpdatePaintNodeData *) override;
+
 signals:
     // level
     void signal_level_min_changed();
     void signal_level_max_changed();
+    void signal_palette_changed();
+    void signal_traces_changed();
+
+    // viewport for ta_spectr
+    void signal_render_view(const render_view &);
 
     // for test
     void signal_power_spectr_test(const QVector<qreal> &value);
@@ -63,18 +107,36 @@ private slots:
     void slot_size_changed();
 
 private:
-    bool is_spectr_max_calc;
+    // shown traces, bit (1 << trace_type)
+    quint32 m_traces {0};
+    bool is_trace(const trace_type &)const;
+    void set_trace(const trace_type &, const bool &);
+
+    // scene graph update flags (updatePaintNode)
+    bool m_chrome_dirty {true};
+    bool m_labels_dirty {true};
+    bool m_traces_dirty {true};
+    // frame of ta_spectr not yet taken (updatePolish, once per frame)
+    bool m_frame_pending {false};
 
     qreal m_split_surface;
     QColor m_color_background;
     QColor m_color_axis;
 
     QPoint m_surface_point;
-    QPoint cursor_point;
+    // cursor over the spectr area (readout), -1: outside
+    QPoint m_cursor_point {-1, -1};
+    qreal m_pan_x {0};
+
+    // sweep history of ta_spectr (sequences) and time of the scrollback
+    qint64 m_history_first {0};
+    qint64 m_history_last {-1};
+    QDateTime m_history_end_time;
 
-    QVector<QPointF> spectr_rt_vector;
-    QVector<qreal> spectr_max_value;
-    QVector<QPointF> spectr_max_vector;
+    // render prep: frames of ta_spectr for m_view
+    QSharedPointer<render_buffer> ptr_render_buffer;
+    render_frame m_front;
+    render_view m_view;
 
     // level
     qreal m_level_min;
@@ -86,20 +148,43 @@ private:
     quint64 m_frequency_max;
     qint32 m_ticket_segment_frequency;
 
+    // static layers: background, axes, grid (chrome) and labels
+    QImage chrome_image();
+    QImage labels_image();
+    // traces without OpenGL (software backend)
+    QImage traces_image()const;
+
     // spectr
     QPoint spectr_size()const;  // size spectr
+    QRectF spectr_area()const;  // trace area
+    void update_render_view();
+
+    // zoom span of the sweep [0, 1] and its frequency range (Hz)
+    void set_span(const qreal &low, const qreal &high);
+    // newest sweep of the waterfall (history sequence), -1: live
+    void set_history_end(const qint64 &value);
+    qreal view_frequency_min()const;
+    qreal view_frequency_max()const;
     void spectr_surface_paint(QPainter *painter);
+    void spectr_labels_paint(QPainter *painter);
+    void set_cursor_point(const QPoint &);
 
     // waterfall
     QPoint waterfall_size()const;   // size waterfall
     QPoint waterfall_point()const;  // start point
+    int waterfall_rows()const;      // sweeps in waterfall
     void waterfall_surface_paint(QPainter *painter);
+    void waterfall_labels_paint(QPainter *painter);
+
+    // label at the text baseline, layouts are cached
+    void draw_label(QPainter *painter, const QPoint &baseline, const QString &text, const Qt::Alignment &align);
+    QFont m_label_font;
+    QHash<QString, QStaticText> m_label_cache;
 
     QMap<QString, spectr_item*> m_spectr_item_list;
 
-    QImage m_image_waterfall;
-    QList<QRgb> m_colors_waterfall;
-    qreal m_sensitivity_waterfall;
+    waterfall_buffer m_waterfall;
+    palette_type m_palette;
     qint32 m_ticket_segment_waterfall;
 
     QPen m_ticket_pen;
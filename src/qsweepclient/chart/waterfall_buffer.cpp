@@ -0,0 +1,113 @@
+#include "waterfall_buffer.h"
+
+#include <cstring>
+
+waterfall_buffer::waterfall_buffer()
+{
+}
+
+void waterfall_buffer::resize(const int &width, const int &rows)
+{
+    if((width <= 0)||(rows <= 0))
+    {
+        m_image = QImage();
+        m_write_row = 0;
+        m_dirty_rows = -1;
+        return;
+    }
+
+    if((width == m_image.width())&&(rows == m_image.height()))
+        return;
+
+    const QImage old_image = to_image();
+
+    if(old_image.isNull())
+    {
+        m_image = QImage(width, rows, QImage::Format_RGB32);
+        m_image.fill(Qt::black);
+    }else{
+        m_image = old_image.scaled(width, rows, Qt::IgnoreAspectRatio, Qt::FastTransformation)
+                .convertToFormat(QImage::Format_RGB32);
+    }
+
+    m_write_row = 0;
+    m_dirty_rows = -1;
+}
+
+void waterfall_buffer::clear(const QColor &color)
+{
+    if(!m_image.isNull())
+        m_image.fill(color);
+
+    m_write_row = 0;
+    m_dirty_rows = -1;
+}
+
+int waterfall_buffer::width() const
+{
+    return m_image.width();
+}
+
+int waterfall_buffer::rows() const
+{
+    return m_image.height();
+}
+
+int waterfall_buffer::write_row() const
+{
+    return m_write_row;
+}
+
+bool waterfall_buffer::is_null() const
+{
+    return m_image.isNull();
+}
+
+QRgb *waterfall_buffer::next_row()
+{
+    if(m_image.isNull())
+        return Q_NULLPTR;
+
+    // moves up, the previous rows stay in place
+    m_write_row = (m_write_row - 1 + m_image.height())%m_image.height();
+
+    if(m_dirty_rows >= 0)
+        m_dirty_rows = (m_dirty_rows + 1 < m_image.height()) ? m_dirty_rows + 1 : -1;
+
+    return reinterpret_cast<QRgb*>(m_image.scanLine(m_write_row));
+}
+
+const QImage &waterfall_buffer::image() const
+{
+    return m_image;
+}
+
+int waterfall_buffer::dirty_rows() const
+{
+    return m_dirty_rows;
+}
+
+void waterfall_buffer::set_dirty()
+{
+    m_dirty_rows = -1;
+}
+
+void waterfall_buffer::reset_dirty()
+{
+    m_dirty_rows = 0;
+}
+
+QImage waterfall_buffer::to_image() const
+{
+    if(m_image.isNull())
+        return QImage();
+
+    QImage image(m_image.size(), m_image.format());
+    const int rows = m_image.height();
+    const int bytes = m_image.bytesPerLine();
+
+    for(int i=0; i<rows; ++i)
+        std::memcpy(image.scanLine(i), m_image.constScanLine((m_write_row + i)%rows), static_cast<size_t>(bytes));
+
+    return image;
+}
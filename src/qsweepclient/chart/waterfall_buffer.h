@@ -0,0 +1,43 @@
+#ifndef WATERFALL_BUFFER_H
+#define WATERFALL_BUFFER_H
+
+#include <QImage>
+
+// waterfall rows in a circular image: a new row is written in place at
+// the write index (one scanline per sweep), the image is not shifted or
+// reallocated per sweep. Newest row is shown on top, the image is drawn
+// as two quads: rows [write_row, rows) then rows [0, write_row)
+class waterfall_buffer
+{
+public:
+    waterfall_buffer();
+
+    // keeps the content (scaled) if the buffer is not empty
+    void resize(const int &width, const int &rows);
+    void clear(const QColor &color);
+
+    int width()const;
+    int rows()const;
+    int write_row()const;
+    bool is_null()const;
+
+    // scanline of the next (newest) row, "width" pixels
+    QRgb *next_row();
+
+    const QImage &image()const;
+
+    // rows written since reset_dirty() (from write_row), -1: whole image
+    int dirty_rows()const;
+    void set_dirty();
+    void reset_dirty();
+
+    // rows in display order (newest first)
+    QImage to_image()const;
+
+private:
+    QImage m_image;
+    int m_write_row {0};
+    int m_dirty_rows {-1};
+};
+
+#endif // WATERFALL_BUFFER_H
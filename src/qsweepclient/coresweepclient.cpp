@@ -39,6 +39,7 @@ CoreSweepClient::CoreSweepClient(QObject *parent) : QObject(parent),
     qRegisterMetaType<data_spectr>();
     qRegisterMetaType<QVector<params_spectr> >();
     qRegisterMetaType<ranges_template>();
+    qRegisterMetaType<render_view>();
 }
 
 int CoreSweepClient::runCoreSweepClient(int argc, char *argv[])
@@ -92,8 +93,20 @@ int CoreSweepClient::runCoreSweepClient(int argc, char *argv[])
     connect(this, &CoreSweepClient::signal_data_spectr,
             ptr_ta_spectr_worker, &ta_spectr::slot_data_spectr);
 
-    connect(ptr_ta_spectr_worker, &ta_spectr::signal_spectr_rt,
-            surfaceSpectr, &surface_spectr::slot_power_spectr);
+    // render prep: frames of ta_spectr, viewport of the surface
+    connect(ptr_ta_spectr_worker, &ta_spectr::signal_frame_ready,
+            surfaceSpectr, &surface_spectr::slot_frame_ready);
+    connect(surfaceSpectr, &surface_spectr::signal_render_view,
+            ptr_ta_spectr_worker, &ta_spectr::slot_render_view);
+
+    // waterfall scrollback
+    const client_settings history_settings = ptr_client_settings ? *ptr_client_settings : client_settings();
+    ptr_ta_spectr_worker->set_history(static_cast<qint64>(history_settings.history_size())*1024*1024,
+                                      history_settings.history_quantize());
+
+    const QSharedPointer<render_buffer> spectr_render_buffer(new render_buffer);
+    ptr_ta_spectr_worker->set_render_buffer(spectr_render_buffer);
+    surfaceSpectr->set_render_buffer(spectr_render_buffer);
 
     ptr_ta_spectr_thread->start();
 
@@ -1,4 +1,5 @@
 import QtQuick 2.4
+import QtQuick.Controls 2.3
 import surfacespectr 1.0
 
 SpectrSurfaceForm {
@@ -84,6 +85,52 @@ SpectrSurfaceForm {
         anchors.fill: item_spectr_surface
     }
 
+    // traces over the spectr (max hold: check_box_max_spectr)
+    Row {
+        anchors.top: idSpectrItem.top
+        anchors.right: idSpectrItem.right
+        anchors.rightMargin: 50
+        height: 30
+
+        CheckBox {
+            height: parent.height
+            text: qsTr("min")
+            font.pointSize: 8
+            onClicked: idSpectrItem.min_hold = checked
+        }
+
+        CheckBox {
+            height: parent.height
+            text: qsTr("average")
+            font.pointSize: 8
+            onClicked: idSpectrItem.average = checked
+        }
+
+        CheckBox {
+            height: parent.height
+            text: qsTr("peak")
+            font.pointSize: 8
+            onClicked: idSpectrItem.peak_decay = checked
+        }
+    }
+
+    // waterfall palette (surface_spectr palette_type)
+    cbx_palette {
+        currentIndex: 0
+        textRole: "key"
+        model: ListModel {
+            id: paletteModel
+            ListElement { key: "classic"; value: 0 }
+            ListElement { key: "viridis"; value: 1 }
+            ListElement { key: "inferno"; value: 2 }
+            ListElement { key: "turbo"; value: 3 }
+        }
+
+        onActivated: {
+            idSpectrItem.palette = paletteModel.get(cbx_palette.currentIndex).value
+        }
+    }
+
     cbx_fft_size {
         currentIndex: 2
         textRole: "key"
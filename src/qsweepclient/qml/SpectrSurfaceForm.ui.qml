@@ -19,6 +19,7 @@ Item {
     property alias cbx_fft_size: cbx_fft_size
     property alias cbx_vga_gain: cbx_vga_gain
     property alias cbx_lna_gain: cbx_lna_gain
+    property alias cbx_palette: cbx_palette
     property alias item_spectr_surface: item_spectr_surface
 
     Item {
@@ -189,5 +190,13 @@ Item {
             text: qsTr("message log")
         }
 
+        ComboBox {
+            id: cbx_palette
+            x: 8
+            y: 476
+            width: 144
+            height: 40
+        }
+
     }
 }
@@ -14,7 +14,15 @@ HEADERS += \
     statesweepclient.h \
     chart/surface_spectr.h \
     chart/spectr_item.h \
+    chart/waterfall_buffer.h \
+    chart/surface_nodes.h \
+    chart/spectr_envelope.h \
+    chart/color_palette.h \
     spectr/ta_spectr.h \
+    spectr/render_frame.h \
+    spectr/spectr_pyramid.h \
+    spectr/spectr_history.h \
+    spectr/trace_engine.h \
     database/db_local_state.h \
     model/params_spectr_model.h \
     user_interface.h
@@ -31,7 +39,15 @@ SOURCES += \
     statesweepclient.cpp \
     chart/surface_spectr.cpp \
     chart/spectr_item.cpp \
+    chart/waterfall_buffer.cpp \
+    chart/surface_nodes.cpp \
+    chart/spectr_envelope.cpp \
+    chart/color_palette.cpp \
     spectr/ta_spectr.cpp \
+    spectr/render_frame.cpp \
+    spectr/spectr_pyramid.cpp \
+    spectr/spectr_history.cpp \
+    spectr/trace_engine.cpp \
     database/db_local_state.cpp \
     model/params_spectr_model.cpp \
     user_interface.cpp
@@ -6,6 +6,8 @@
 static const QString HOST_BROKER_KEY = QStringLiteral("host_broker");
 static const QString PORT_BROKER_KEY = QStringLiteral("port_broker");
 static const QString MAX_SIZE_MESSAGE_LOG_KEY = QStringLiteral("max_size_message_log");
+static const QString HISTORY_SIZE_KEY = QStringLiteral("history_size");
+static const QString HISTORY_QUANTIZE_KEY = QStringLiteral("history_quantize");
 
 class sweep_client_settings_data : public QSharedData {
 public:
@@ -15,6 +17,8 @@ public:
         m_host_broker = "127.0.0.1";
         m_port_broker = 1883;
         m_max_size_message_log = 20;
+        m_history_size = 64;
+        m_history_quantize = false;
     }
     sweep_client_settings_data(const sweep_client_settings_data &other) : QSharedData(other)
     {
@@ -22,6 +26,8 @@ public:
         m_host_broker = other.m_host_broker;
         m_port_broker = other.m_port_broker;
         m_max_size_message_log = other.m_max_size_message_log;
+        m_history_size = other.m_history_size;
+        m_history_quantize = other.m_history_quantize;
     }
 
     ~sweep_client_settings_data() {}
@@ -30,6 +36,8 @@ public:
     QString m_host_broker;
     quint16 m_port_broker;
     qint32 m_max_size_message_log;
+    qint32 m_history_size;
+    bool m_history_quantize;
 };
 
 client_settings::client_settings() : data(new sweep_client_settings_data)
@@ -50,6 +58,8 @@ client_settings::client_settings(const QByteArray &json) : data(new sweep_client
     data->m_host_broker = json_object.value(HOST_BROKER_KEY).toString();
     data->m_port_broker = json_object.value(PORT_BROKER_KEY).toString().toUShort();
     data->m_max_size_message_log = json_object.value(MAX_SIZE_MESSAGE_LOG_KEY).toInt(5);
+    data->m_history_size = json_object.value(HISTORY_SIZE_KEY).toInt(64);
+    data->m_history_quantize = json_object.value(HISTORY_QUANTIZE_KEY).toBool(false);
 
     if(!doc.isEmpty())
         data->m_valid = true;
@@ -104,12 +114,34 @@ qint32 client_settings::max_size_message_log() const
     return  data->m_max_size_message_log;
 }
 
+void client_settings::set_history_size(const qint32 &value)
+{
+    data->m_history_size = value;
+}
+
+qint32 client_settings::history_size() const
+{
+    return data->m_history_size;
+}
+
+void client_settings::set_history_quantize(const bool &value)
+{
+    data->m_history_quantize = value;
+}
+
+bool client_settings::history_quantize() const
+{
+    return data->m_history_quantize;
+}
+
 QByteArray client_settings::to_json() const
 {
     QJsonObject json_object;
     json_object.insert(HOST_BROKER_KEY, data->m_host_broker);
     json_object.insert(PORT_BROKER_KEY, QString::number(data->m_port_broker));
     json_object.insert(MAX_SIZE_MESSAGE_LOG_KEY, data->m_max_size_message_log);
+    json_object.insert(HISTORY_SIZE_KEY, data->m_history_size);
+    json_object.insert(HISTORY_QUANTIZE_KEY, data->m_history_quantize);
 
     QJsonDocument doc(json_object);
 
@@ -26,6 +26,13 @@ public:
     void set_max_size_message_log(const qint32 &);
     qint32 max_size_message_log()const;
 
+    // waterfall scrollback: sweep history (MB), int8 levels
+    void set_history_size(const qint32 &);
+    qint32 history_size()const;
+
+    void set_history_quantize(const bool &);
+    bool history_quantize()const;
+
     QByteArray to_json() const;
 
 private:
@@ -0,0 +1,108 @@
+#include "render_frame.h"
+
+#include <cstring>
+
+QRgb *render_frame::append_row(const qint32 &width)
+{
+    if(width <= 0)
+        return Q_NULLPTR;
+
+    // rows of another viewport are dropped
+    if(m_row_width != width)
+        clear_rows();
+
+    m_row_width = width;
+    m_rows.resize((m_row_count + 1)*width);
+
+    return m_rows.data() + (m_row_count++)*width;
+}
+
+void render_frame::clear_rows()
+{
+    m_rows.resize(0);
+    m_row_count = 0;
+    m_rows_reset = false;
+}
+
+void render_frame::limit_rows()
+{
+    if((m_row_limit <= 0)||(m_row_count <= m_row_limit))
+        return;
+
+    const qint32 drop = m_row_count - m_row_limit;
+
+    m_rows.remove(0, drop*m_row_width);
+    m_row_count = m_row_limit;
+}
+
+void render_frame::swap(render_frame &other)
+{
+    qSwap(m_view_id, other.m_view_id);
+    qSwap(m_date_time, other.m_date_time);
+    qSwap(m_frequency_min, other.m_frequency_min);
+    qSwap(m_frequency_max, other.m_frequency_max);
+
+    m_spectr_rt.swap(other.m_spectr_rt);
+    for(int i=0; i<trace_count; ++i)
+        m_traces[i].swap(other.m_traces[i]);
+
+    m_noise_floor.swap(other.m_noise_floor);
+
+    qSwap(m_row_width, other.m_row_width);
+    qSwap(m_row_count, other.m_row_count);
+    qSwap(m_row_limit, other.m_row_limit);
+    qSwap(m_rows_reset, other.m_rows_reset);
+    m_rows.swap(other.m_rows);
+
+    qSwap(m_history_first, other.m_history_first);
+    qSwap(m_history_last, other.m_history_last);
+    qSwap(m_history_end, other.m_history_end);
+    qSwap(m_history_end_time, other.m_history_end_time);
+}
+
+bool render_buffer::publish(render_frame &back)
+{
+    QMutexLocker locker(&m_mutex);
+
+    const bool is_notify = !m_pending;
+
+    if(m_pending && (m_ready.m_row_count > 0) && (m_ready.m_row_width == back.m_row_width) && (!back.m_rows_reset))
+    {
+        // the GUI is behind: keep the rows it has not taken yet
+        const qint32 count = back.m_row_count;
+        const QRgb *rows = back.m_rows.constData();
+
+        for(qint32 i=0; i<count; ++i)
+            std::memcpy(m_ready.append_row(back.m_row_width), rows + i*back.m_row_width,
+                        static_cast<size_t>(back.m_row_width)*sizeof(QRgb));
+
+        m_ready.m_row_limit = back.m_row_limit;
+        m_ready.limit_rows();
+
+        // all rows go back with the new traces (swap below)
+        back.m_rows.swap(m_ready.m_rows);
+        qSwap(back.m_row_count, m_ready.m_row_count);
+        back.m_rows_reset = m_ready.m_rows_reset;
+    }
+
+    m_ready.swap(back);
+    m_pending = true;
+
+    back.clear_rows();
+
+    return is_notify;
+}
+
+bool render_buffer::take(render_frame &front)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if(!m_pending)
+        return false;
+
+    m_ready.swap(front);
+    m_ready.clear_rows();
+    m_pending = false;
+
+    return true;
+}
@@ -0,0 +1,90 @@
+#ifndef RENDER_FRAME_H
+#define RENDER_FRAME_H
+
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+#include <QDateTime>
+#include <QMutex>
+#include <QColor>
+#include <QtCore/qmetatype.h>
+
+#include "chart/color_palette.h"
+#include "trace_engine.h"
+
+// viewport of surface_spectr, sent to ta_spectr on resize, level, palette
+// and max spectr change. m_id tags the frames made for it
+struct render_view
+{
+    quint32 m_id = 0;
+    QRectF m_area;                  // spectr trace area (item coordinates)
+    qint32 m_waterfall_width = 0;   // pixels of a waterfall row
+    qint32 m_waterfall_rows = 0;    // rows of the waterfall
+    qreal m_level_min = -100;
+    qreal m_level_max = 0;
+    palette_type m_palette = palette_type::classic;
+    quint32 m_traces = 0;           // shown traces, bit (1 << trace_type)
+    // zoom: part of the sweep range shown, [0, 1]
+    qreal m_span_low = 0;
+    qreal m_span_high = 1;
+    // scrollback: history sequence of the newest waterfall row, -1: live
+    qint64 m_history_end = -1;
+};
+
+// output of ta_spectr for surface_spectr: trace points of the latest sweep
+// and the waterfall rows of every sweep since the previous frame
+struct render_frame
+{
+    quint32 m_view_id = 0;
+    QDateTime m_date_time;
+    quint64 m_frequency_min = 0;
+    quint64 m_frequency_max = 0;
+
+    QVector<QPointF> m_spectr_rt;
+    QVector<QPointF> m_traces[trace_count];   // by trace_type
+    QVector<QPointF> m_noise_floor;
+
+    // m_row_count rows of m_row_width pixels, oldest first. m_rows_reset:
+    // the rows replace the whole waterfall (rendered from the history).
+    // m_row_limit: rows of the waterfall, older rows are never shown
+    qint32 m_row_width = 0;
+    qint32 m_row_count = 0;
+    qint32 m_row_limit = 0;
+    bool m_rows_reset = false;
+    QVector<QRgb> m_rows;
+
+    // sweep history (sequences), waterfall end and its time
+    qint64 m_history_first = 0;
+    qint64 m_history_last = -1;
+    qint64 m_history_end = -1;
+    QDateTime m_history_end_time;
+
+    QRgb *append_row(const qint32 &width);
+    void clear_rows();
+    // drop the oldest rows above m_row_limit (0 - no limit)
+    void limit_rows();
+    void swap(render_frame &other);
+};
+
+// double buffer between ta_spectr (producer) and surface_spectr (GUI
+// thread): frames are swapped under the lock, never copied, unless the GUI
+// has not taken the previous frame (its waterfall rows are kept, at most
+// m_row_limit of them: the window may not be exposed for a long time)
+class render_buffer
+{
+public:
+    // true if a frame was not pending (the GUI has to be notified)
+    bool publish(render_frame &back);
+
+    // false if there is no new frame since the previous take()
+    bool take(render_frame &front);
+
+private:
+    QMutex m_mutex;
+    render_frame m_ready;
+    bool m_pending {false};
+};
+
+Q_DECLARE_METATYPE(render_view)
+
+#endif // RENDER_FRAME_H
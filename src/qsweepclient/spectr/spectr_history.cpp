@@ -0,0 +1,154 @@
+#include "spectr_history.h"
+
+#include <cstring>
+#include <cmath>
+#include <climits>
+
+// int8 quantization of a level: code = (dB - offset)/step
+static const qreal quantize_offset = -50;
+static const qreal quantize_step = 0.5;
+
+void spectr_history::set_capacity(const qint64 &bytes)
+{
+    if(bytes == m_capacity)
+        return;
+
+    // one QByteArray arena
+    m_capacity = qBound(Q_INT64_C(0), bytes, static_cast<qint64>(INT_MAX));
+    clear();
+}
+
+qint64 spectr_history::capacity() const
+{
+    return m_capacity;
+}
+
+void spectr_history::set_quantize(const bool &value)
+{
+    if(value == m_quantize)
+        return;
+
+    m_quantize = value;
+    clear();
+}
+
+bool spectr_history::is_quantize() const
+{
+    return m_quantize;
+}
+
+void spectr_history::append(const QDateTime &dt, const quint64 &freq_min, const quint64 &freq_max, const QVector<qreal> &values)
+{
+    if(values.isEmpty()||(m_capacity <= 0))
+        return;
+
+    // new layout: new history in the same arena
+    if((values.size() != m_bins)||(freq_min != m_frequency_min)||(freq_max != m_frequency_max))
+    {
+        m_bins = values.size();
+        m_frequency_min = freq_min;
+        m_frequency_max = freq_max;
+        m_appended = 0;
+
+        const qint64 sweep_size = static_cast<qint64>(m_bins)*sample_size();
+        m_slots = static_cast<qint32>(qMin(m_capacity/sweep_size, static_cast<qint64>(INT_MAX)));
+
+        if(m_arena.size() != m_slots*sweep_size)
+            m_arena.resize(static_cast<int>(m_slots*sweep_size));
+
+        m_date_time.resize(m_slots);
+    }
+
+    if(m_slots <= 0)
+        return;
+
+    const int slot = static_cast<int>(m_appended % m_slots);
+    const qreal *source = values.constData();
+
+    if(m_quantize)
+    {
+        qint8 *target = reinterpret_cast<qint8*>(m_arena.data()) + static_cast<qint64>(slot)*m_bins;
+
+        for(int i=0; i<m_bins; ++i)
+            target[i] = static_cast<qint8>(qBound(-128.0, std::round((source[i] - quantize_offset)/quantize_step), 127.0));
+    }else{
+        float *target = reinterpret_cast<float*>(m_arena.data()) + static_cast<qint64>(slot)*m_bins;
+
+        for(int i=0; i<m_bins; ++i)
+            target[i] = static_cast<float>(source[i]);
+    }
+
+    m_date_time[slot] = dt.toMSecsSinceEpoch();
+    m_appended++;
+}
+
+void spectr_history::clear()
+{
+    m_bins = 0;
+    m_slots = 0;
+    m_appended = 0;
+    m_frequency_min = 0;
+    m_frequency_max = 0;
+
+    m_arena.clear();
+    m_date_time.clear();
+}
+
+qint32 spectr_history::count() const
+{
+    return static_cast<qint32>(qMin(m_appended, static_cast<qint64>(m_slots)));
+}
+
+qint32 spectr_history::bins() const
+{
+    return m_bins;
+}
+
+qint64 spectr_history::last_sequence() const
+{
+    return m_appended - 1;
+}
+
+bool spectr_history::contains(const qint64 &sequence) const
+{
+    return (sequence < m_appended)&&(sequence >= m_appended - count());
+}
+
+void spectr_history::read(const qint64 &sequence, qreal *values) const
+{
+    if((!values)||(!contains(sequence)))
+        return;
+
+    const int slot = slot_of(sequence);
+
+    if(m_quantize)
+    {
+        const qint8 *source = reinterpret_cast<const qint8*>(m_arena.constData()) + static_cast<qint64>(slot)*m_bins;
+
+        for(int i=0; i<m_bins; ++i)
+            values[i] = source[i]*quantize_step + quantize_offset;
+    }else{
+        const float *source = reinterpret_cast<const float*>(m_arena.constData()) + static_cast<qint64>(slot)*m_bins;
+
+        for(int i=0; i<m_bins; ++i)
+            values[i] = static_cast<qreal>(source[i]);
+    }
+}
+
+QDateTime spectr_history::date_time(const qint64 &sequence) const
+{
+    if(!contains(sequence))
+        return QDateTime();
+
+    return QDateTime::fromMSecsSinceEpoch(m_date_time.at(slot_of(sequence)));
+}
+
+int spectr_history::slot_of(const qint64 &sequence) const
+{
+    return static_cast<int>(sequence % m_slots);
+}
+
+int spectr_history::sample_size() const
+{
+    return m_quantize ? static_cast<int>(sizeof(qint8)) : static_cast<int>(sizeof(float));
+}
@@ -0,0 +1,55 @@
+#ifndef SPECTR_HISTORY_H
+#define SPECTR_HISTORY_H
+
+#include <QVector>
+#include <QByteArray>
+#include <QDateTime>
+
+// last sweeps of one range at native bin resolution, for the waterfall
+// scrollback and re-rendering at any size. The arena is allocated once
+// (capacity bytes) and used as a circular buffer of sweeps: float32 bins
+// or int8 (0.5 dB steps around -50 dB, [-114, 13.5] dB). A new range or
+// bin count starts a new history
+class spectr_history
+{
+public:
+    void set_capacity(const qint64 &bytes);
+    qint64 capacity()const;
+
+    void set_quantize(const bool &);
+    bool is_quantize()const;
+
+    void append(const QDateTime &dt, const quint64 &freq_min, const quint64 &freq_max, const QVector<qreal> &values);
+    void clear();
+
+    // sweeps in the history, bins of a sweep
+    qint32 count()const;
+    qint32 bins()const;
+
+    // total sweeps appended to this history: "sequence" of a sweep is its
+    // index in that count, count() last ones are kept
+    qint64 last_sequence()const;
+    bool contains(const qint64 &sequence)const;
+
+    // bins of a sweep, "values" has bins() elements
+    void read(const qint64 &sequence, qreal *values)const;
+    QDateTime date_time(const qint64 &sequence)const;
+
+private:
+    qint64 m_capacity {0};
+    bool m_quantize {false};
+
+    quint64 m_frequency_min {0};
+    quint64 m_frequency_max {0};
+    qint32 m_bins {0};
+    qint32 m_slots {0};     // sweeps of the arena
+    qint64 m_appended {0};  // sweeps appended
+
+    QByteArray m_arena;
+    QVector<qint64> m_date_time;
+
+    int slot_of(const qint64 &sequence)const;
+    int sample_size()const;
+};
+
+#endif // SPECTR_HISTORY_H
@@ -0,0 +1,74 @@
+#include "spectr_pyramid.h"
+
+void spectr_pyramid::update(const QVector<qreal> &values)
+{
+    if(values.isEmpty())
+    {
+        clear();
+        return;
+    }
+
+    if(m_levels.isEmpty())
+        m_levels.resize(1);
+
+    // level 0 shares the sweep (implicit sharing, no copy)
+    m_levels[0] = values;
+
+    int level = 1;
+
+    for(int size = values.size(); size > 1; ++level)
+    {
+        const int next_size = (size + 1)/2;
+
+        if(m_levels.size() <= level)
+            m_levels.resize(level + 1);
+
+        const qreal *source = m_levels.at(level - 1).constData();
+
+        QVector<qreal> &target = m_levels[level];
+        target.resize(next_size);
+
+        qreal *data = target.data();
+
+        for(int i=0; i<size/2; ++i)
+            data[i] = qMax(source[i*2], source[i*2 + 1]);
+
+        if(size & 1)
+            data[next_size - 1] = source[size - 1];
+
+        size = next_size;
+    }
+
+    m_levels.resize(level);
+}
+
+void spectr_pyramid::clear()
+{
+    m_levels.clear();
+}
+
+int spectr_pyramid::size() const
+{
+    return m_levels.isEmpty() ? 0 : m_levels.at(0).size();
+}
+
+const qreal *spectr_pyramid::range(int &first, int &last, const int &columns) const
+{
+    if(m_levels.isEmpty())
+        return Q_NULLPTR;
+
+    first = qBound(0, first, size() - 1);
+    last = qBound(first + 1, last, size());
+
+    // coarsest level with at least "columns" bins in the range
+    int level = 0;
+
+    while((level + 1 < m_levels.size())&&(((last - first) >> (level + 1)) >= qMax(1, columns)))
+        ++level;
+
+    first >>= level;
+    last = qMax(first + 1, (last + (1 << level) - 1) >> level);
+    last = qMin(last, m_levels.at(level).size());
+
+    return m_levels.at(level).constData();
+}
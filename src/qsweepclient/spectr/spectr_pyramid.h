@@ -0,0 +1,28 @@
+#ifndef SPECTR_PYRAMID_H
+#define SPECTR_PYRAMID_H
+
+#include <QVector>
+
+// multi-resolution levels of a sweep: level 0 is the sweep, every next
+// level holds the max of two bins of the previous one (peaks are kept).
+// A zoomed range is read at the coarsest level that still has one bin per
+// pixel, so the cost of a view does not depend on the sweep size
+class spectr_pyramid
+{
+public:
+    // new sweep, levels are rebuilt in place (about 2 x bins)
+    void update(const QVector<qreal> &values);
+    void clear();
+
+    // bins of level 0
+    int size()const;
+
+    // bins [first, last) of level 0 for "columns" pixels: first and last
+    // are set to the range of the returned level
+    const qreal *range(int &first, int &last, const int &columns)const;
+
+private:
+    QVector<QVector<qreal> > m_levels;
+};
+
+#endif // SPECTR_PYRAMID_H
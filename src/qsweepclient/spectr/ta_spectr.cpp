@@ -1,5 +1,8 @@
 #include "ta_spectr.h"
 #include "data_spectr.h"
+#include "chart/spectr_envelope.h"
+
+#include <cmath>
 
 #ifdef QT_DEBUG
 #include <QtCore/qdebug.h>
@@ -9,25 +12,194 @@ ta_spectr::ta_spectr(QObject *parent) : QObject(parent)
 {
 }
 
-void ta_spectr::slot_data_spectr(const data_spectr &data)
+void ta_spectr::set_render_buffer(const QSharedPointer<render_buffer> &value)
+{
+    ptr_render_buffer = value;
+}
+
+void ta_spectr::set_history(const qint64 &capacity, const bool &quantize)
 {
+    m_history.set_quantize(quantize);
+    m_history.set_capacity(capacity);
+}
+
+void ta_spectr::slot_data_spectr(const data_spectr &value)
+{
+    data_spectr data(value);
+
+    if(!m_sparse_decoder.decode(data))
+        return;
+
     QVector<power_spectr> tmp_spectr(data.spectr());
 
     std::sort(tmp_spectr.begin(), tmp_spectr.end(), [](const power_spectr& a, const power_spectr& b) {
         return a.hz_low < b.hz_low;
     });
 
-    if(tmp_spectr.size()>0)
+    if(tmp_spectr.isEmpty())
+        return;
+
+    QVector<qreal> tmp_power_rt;
+    QVector<qreal> tmp_noise_floor_rt;
+    bool is_noise_floor(true);
+
+    for(qint32 i=0; i<tmp_spectr.size(); ++i)
     {
-        QVector<qreal> tmp_power_rt;
+        tmp_power_rt.append(tmp_spectr.at(i).m_power);
+
+        is_noise_floor = is_noise_floor&&(tmp_spectr.at(i).m_noise_floor.size() == tmp_spectr.at(i).m_power.size());
+
+        if(is_noise_floor)
+            tmp_noise_floor_rt.append(tmp_spectr.at(i).m_noise_floor);
+    }
+
+    const quint64 frequency_min = tmp_spectr.at(0).hz_low;
+    const quint64 frequency_max = tmp_spectr.at(tmp_spectr.size()-1).hz_high;
+
+    // traces of the same params, range and bins
+    m_traces.update(data.id_params(), frequency_min, frequency_max, tmp_power_rt);
 
-        for(qint32 i=0; i<tmp_spectr.size(); ++i)
-            tmp_power_rt.append(tmp_spectr.at(i).m_power);
+    m_date_time = tmp_spectr.at(0).m_date_time;
+    m_frequency_min = frequency_min;
+    m_frequency_max = frequency_max;
+    m_power.swap(tmp_power_rt);
 
-        const auto dt = tmp_spectr.at(0).m_date_time;
+    if(is_noise_floor)
+        m_noise_floor.swap(tmp_noise_floor_rt);
+    else
+        m_noise_floor.clear();
 
-        emit signal_spectr_rt(dt, tmp_spectr.at(0).hz_low, tmp_spectr.at(tmp_spectr.size()-1).hz_high, tmp_power_rt);
+    m_power_pyramid.update(m_power);
+    m_history.append(m_date_time, m_frequency_min, m_frequency_max, m_power);
 
-        qDebug() << "if(tmp_spectr.size()>0)";
+    // waterfall row of every sweep (zoom span), frozen in scrollback
+    QRgb *row = m_view.m_history_end < 0 ? m_back.append_row(m_view.m_waterfall_width) : Q_NULLPTR;
+
+    if(row)
+    {
+        int first = 0;
+        int last = 0;
+        span_bins(m_power.size(), first, last);
+
+        const qreal *values = m_power_pyramid.range(first, last, m_view.m_waterfall_width);
+        m_palette.map_row(values ? values + first : Q_NULLPTR, last - first, row, m_view.m_waterfall_width);
     }
+
+    update_history_state();
+    update_traces();
+    publish();
+}
+
+void ta_spectr::slot_render_view(const render_view &value)
+{
+    m_view = value;
+
+    m_palette.set_palette(m_view.m_palette);
+    m_palette.set_levels(m_view.m_level_min, m_view.m_level_max);
+
+    for(int i=0; i<trace_count; ++i)
+        m_traces.set_enabled(static_cast<trace_type>(i), m_view.m_traces & (1u << i));
+
+    // latest sweep and the waterfall of the history in the new viewport
+    m_back.clear_rows();
+    update_waterfall();
+    update_history_state();
+    update_traces();
+    publish();
+}
+
+void ta_spectr::update_traces()
+{
+    // min/max envelope per pixel column of the view
+    m_back.m_view_id = m_view.m_id;
+    m_back.m_date_time = m_date_time;
+    m_back.m_frequency_min = m_frequency_min;
+    m_back.m_frequency_max = m_frequency_max;
+
+    const int columns = qMax(1, static_cast<int>(m_view.m_area.width()));
+
+    // zoom span at the level with about one bin per pixel
+    int first = 0;
+    int last = 0;
+    span_bins(m_power.size(), first, last);
+
+    const qreal *values = m_power_pyramid.range(first, last, columns);
+    m_back.m_spectr_rt = envelope_points(values ? values + first : Q_NULLPTR, last - first,
+                                         m_view.m_area, m_view.m_level_min, m_view.m_level_max);
+
+    for(int i=0; i<trace_count; ++i)
+    {
+        const QVector<float> &trace = m_traces.trace(static_cast<trace_type>(i));
+
+        span_bins(trace.size(), first, last);
+        m_back.m_traces[i] = envelope_points(trace.constData() + first, last - first,
+                                             m_view.m_area, m_view.m_level_min, m_view.m_level_max);
+    }
+
+    span_bins(m_noise_floor.size(), first, last);
+    m_back.m_noise_floor = envelope_points(m_noise_floor.constData() + first, last - first,
+                                           m_view.m_area, m_view.m_level_min, m_view.m_level_max);
+}
+
+void ta_spectr::update_waterfall()
+{
+    const qint32 rows = m_view.m_waterfall_rows;
+    const qint32 width = m_view.m_waterfall_width;
+
+    // without history the item keeps its (scaled) rows
+    if((m_history.count() == 0)||(rows <= 0)||(width <= 0))
+        return;
+
+    qint64 end = m_view.m_history_end < 0 ? m_history.last_sequence() : m_view.m_history_end;
+    end = qBound(m_history.last_sequence() - m_history.count() + 1, end, m_history.last_sequence());
+
+    int first = 0;
+    int last = 0;
+    span_bins(m_history.bins(), first, last);
+
+    m_history_row.resize(m_history.bins());
+
+    // oldest first, the newest row ends on top
+    for(qint64 sequence = end - rows + 1; sequence <= end; ++sequence)
+    {
+        if(!m_history.contains(sequence))
+            continue;
+
+        m_history.read(sequence, m_history_row.data());
+        m_palette.map_row(m_history_row.constData() + first, last - first, m_back.append_row(width), width);
+    }
+
+    m_back.m_rows_reset = true;
+}
+
+void ta_spectr::update_history_state()
+{
+    m_back.m_history_first = m_history.last_sequence() - m_history.count() + 1;
+    m_back.m_history_last = m_history.last_sequence();
+    m_back.m_history_end = (m_view.m_history_end < 0)||(m_history.count() == 0) ? -1
+                                : qBound(m_back.m_history_first, m_view.m_history_end, m_back.m_history_last);
+    m_back.m_history_end_time = m_history.date_time(m_back.m_history_end);
+}
+
+void ta_spectr::span_bins(const int &size, int &first, int &last) const
+{
+    const qreal span_low = qBound(0.0, m_view.m_span_low, 1.0);
+    const qreal span_high = qBound(span_low, m_view.m_span_high, 1.0);
+
+    first = qBound(0, static_cast<int>(span_low*size), qMax(0, size - 1));
+    last = qBound(qMin(first + 1, size), static_cast<int>(std::ceil(span_high*size)), size);
+}
+
+void ta_spectr::publish()
+{
+    if(ptr_render_buffer.isNull())
+    {
+        m_back.clear_rows();
+        return;
+    }
+
+    m_back.m_row_limit = m_view.m_waterfall_rows;
+
+    if(ptr_render_buffer->publish(m_back))
+        emit signal_frame_ready();
 }
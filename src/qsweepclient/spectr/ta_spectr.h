@@ -2,20 +2,70 @@
 #define TA_SPECTR_H
 
 #include <QObject>
+#include <QSharedPointer>
 
-class data_spectr;
+#include "spectr_sparse.h"
+#include "render_frame.h"
+#include "spectr_pyramid.h"
+#include "spectr_history.h"
+#include "trace_engine.h"
 
+// render prep of the spectr surface: sweeps are assembled, the max spectr
+// is held and trace points and waterfall rows are computed here for the
+// current render_view, the GUI thread only takes the frame (render_buffer)
 class ta_spectr : public QObject
 {
     Q_OBJECT
 public:
     explicit ta_spectr(QObject *parent = nullptr);
 
+    void set_render_buffer(const QSharedPointer<render_buffer> &);
+
+    // waterfall scrollback (bytes of the sweep arena, int8 levels)
+    void set_history(const qint64 &capacity, const bool &quantize);
+
 signals:
-    void signal_spectr_rt(const QDateTime &, const quint64 &, const quint64 &, const QVector<qreal> &);
+    // new frame in the render buffer
+    void signal_frame_ready();
 
 public slots:
     void slot_data_spectr(const data_spectr &);
+    void slot_render_view(const render_view &);
+
+private:
+    // rebuilds full sweep from sparse updates of the server
+    sparse_decoder m_sparse_decoder;
+
+    QSharedPointer<render_buffer> ptr_render_buffer;
+    render_frame m_back;
+    render_view m_view;
+    color_palette m_palette;
+
+    // latest sweep
+    QDateTime m_date_time;
+    quint64 m_frequency_min {0};
+    quint64 m_frequency_max {0};
+    QVector<qreal> m_power;
+    QVector<qreal> m_noise_floor;
+
+    // zoom levels of m_power
+    spectr_pyramid m_power_pyramid;
+
+    // max/min hold, average and peak decay of the sweeps
+    trace_engine m_traces;
+
+    // last sweeps at native resolution
+    spectr_history m_history;
+    QVector<qreal> m_history_row;
+
+    // bins [first, last) of the sweep in the zoom span
+    void span_bins(const int &size, int &first, int &last)const;
+    // all rows of the waterfall view from the history
+    void update_waterfall();
+    void update_history_state();
+
+    void update_traces();
+    void publish();
 };
 
 #endif // TA_SPECTR_H
@@ -0,0 +1,128 @@
+#include "trace_engine.h"
+
+void trace_engine::set_enabled(const trace_type &type, const bool &value)
+{
+    const int index = static_cast<int>(type);
+
+    m_enabled[index] = value;
+
+    // restarts on the next sweep
+    if(!value)
+        m_traces[index].clear();
+}
+
+bool trace_engine::is_enabled(const trace_type &type) const
+{
+    return m_enabled[static_cast<int>(type)];
+}
+
+bool trace_engine::is_any_enabled() const
+{
+    for(int i=0; i<trace_count; ++i)
+        if(m_enabled[i])
+            return true;
+
+    return false;
+}
+
+void trace_engine::set_average_alpha(const float &value)
+{
+    m_average_alpha = qBound(0.001f, value, 1.0f);
+}
+
+float trace_engine::average_alpha() const
+{
+    return m_average_alpha;
+}
+
+void trace_engine::set_decay(const float &value)
+{
+    m_decay = qMax(0.0f, value);
+}
+
+float trace_engine::decay() const
+{
+    return m_decay;
+}
+
+void trace_engine::update(const QString &id_params, const quint64 &freq_min, const quint64 &freq_max, const QVector<qreal> &power)
+{
+    if(!is_any_enabled())
+        return;
+
+    const int size = power.size();
+
+    // new layout: all traces restart
+    if((id_params != m_id_params)||(freq_min != m_frequency_min)||(freq_max != m_frequency_max)||(size != m_input.size()))
+    {
+        reset();
+
+        m_id_params = id_params;
+        m_frequency_min = freq_min;
+        m_frequency_max = freq_max;
+    }
+
+    m_input.resize(size);
+
+    const qreal *source = power.constData();
+    float *input = m_input.data();
+
+    for(int i=0; i<size; ++i)
+        input[i] = static_cast<float>(source[i]);
+
+    const float alpha = m_average_alpha;
+    const float decay = m_decay;
+
+    for(int t=0; t<trace_count; ++t)
+    {
+        if(!m_enabled[t])
+            continue;
+
+        // first sweep of the trace
+        if(m_traces[t].size() != size)
+        {
+            m_traces[t] = m_input;
+            continue;
+        }
+
+        float *trace = m_traces[t].data();
+
+        switch (static_cast<trace_type>(t)) {
+        case trace_type::max_hold:
+            for(int i=0; i<size; ++i)
+                trace[i] = trace[i] > input[i] ? trace[i] : input[i];
+            break;
+        case trace_type::min_hold:
+            for(int i=0; i<size; ++i)
+                trace[i] = trace[i] < input[i] ? trace[i] : input[i];
+            break;
+        case trace_type::average:
+            for(int i=0; i<size; ++i)
+                trace[i] += alpha*(input[i] - trace[i]);
+            break;
+        case trace_type::peak_decay:
+            for(int i=0; i<size; ++i)
+            {
+                const float value = trace[i] - decay;
+                trace[i] = value > input[i] ? value : input[i];
+            }
+            break;
+        }
+    }
+}
+
+void trace_engine::reset()
+{
+    for(int i=0; i<trace_count; ++i)
+        m_traces[i].clear();
+
+    m_input.clear();
+    m_id_params.clear();
+    m_frequency_min = 0;
+    m_frequency_max = 0;
+}
+
+const QVector<float> &trace_engine::trace(const trace_type &type) const
+{
+    return m_traces[static_cast<int>(type)];
+}
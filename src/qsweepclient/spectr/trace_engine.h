@@ -0,0 +1,56 @@
+#ifndef TRACE_ENGINE_H
+#define TRACE_ENGINE_H
+
+#include <QVector>
+#include <QString>
+
+// traces over the sweeps of one layout
+enum class trace_type: qint32 {
+    max_hold = 0,
+    min_hold,
+    average,        // exponential average
+    peak_decay      // max hold falling by "decay" dB per sweep
+};
+
+static const int trace_count = 4;
+
+// per bin traces of the sweeps: float arrays updated in place with flat,
+// branch free loops (vectorized by the compiler). All traces restart from
+// the current sweep on a new id_params, bin count or frequency range
+class trace_engine
+{
+public:
+    void set_enabled(const trace_type &, const bool &);
+    bool is_enabled(const trace_type &)const;
+    bool is_any_enabled()const;
+
+    // weight of the new sweep (0, 1]
+    void set_average_alpha(const float &);
+    float average_alpha()const;
+
+    // dB per sweep
+    void set_decay(const float &);
+    float decay()const;
+
+    void update(const QString &id_params, const quint64 &freq_min, const quint64 &freq_max, const QVector<qreal> &power);
+    void reset();
+
+    // bins of the trace, empty if disabled or no sweep
+    const QVector<float> &trace(const trace_type &)const;
+
+private:
+    bool m_enabled[trace_count] = {false, false, false, false};
+    QVector<float> m_traces[trace_count];
+
+    float m_average_alpha {0.1f};
+    float m_decay {0.5f};
+
+    // layout of the traces
+    QString m_id_params;
+    quint64 m_frequency_min {0};
+    quint64 m_frequency_max {0};
+
+    QVector<float> m_input;
+};
+
+#endif // TRACE_ENGINE_H
@@ -161,6 +161,8 @@ void user_interface::onRequestSweepSpectr(const bool &start)
     params_spectr_data.set_start_spectr(start);
 
     ctrl_spectr.set_data_message(params_spectr_data.to_json());
+    // writers route params with the sweeps that start at frequency_min
+    ctrl_spectr.set_route(params_spectr_data.id_params(), static_cast<quint64>(m_freqMin)*1000000);
 
     emit signal_sweep_message(ctrl_spectr.to_json());
 }
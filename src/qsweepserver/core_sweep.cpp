@@ -112,6 +112,16 @@ void core_sweep::init_spectrum_native_worker()
     connect(ptr_spectrum_native_worker, &spectrum_native_worker::signal_sweep_worker,
             this, &core_sweep::slot_sweep_worker);
 
+    // noise floor (sweeps are built by the instance called from rx callback)
+    if(ptr_server_settings->noise_floor())
+        spectrum_native_worker::getInstance()->set_noise_floor(ptr_server_settings->noise_floor_quantile(),
+                                                               ptr_server_settings->noise_floor_window());
+
+    // sparse update (after noise floor, it is computed on the full sweep)
+    if(ptr_server_settings->sparse_update())
+        spectrum_native_worker::getInstance()->set_sparse_update(ptr_server_settings->sparse_threshold(),
+                                                                 ptr_server_settings->sparse_refresh());
+
     // Power spectr
     connect(spectrum_native_worker::getInstance(), &spectrum_native_worker::signal_sweep_message,
             this, &core_sweep::slot_publish_message);
@@ -145,6 +155,16 @@ void core_sweep::init_spectrum_process_worker()
 
     // parser hackrf_sweep stdout
     ptr_parser_worker = new parser_worker;
+
+    if(ptr_server_settings->noise_floor())
+        ptr_parser_worker->set_noise_floor(ptr_server_settings->noise_floor_quantile(),
+                                           ptr_server_settings->noise_floor_window());
+
+    // sparse update (after noise floor, it is computed on the full sweep)
+    if(ptr_server_settings->sparse_update())
+        ptr_parser_worker->set_sparse_update(ptr_server_settings->sparse_threshold(),
+                                             ptr_server_settings->sparse_refresh());
+
     ptr_parser_thread = new QThread;
     ptr_parser_worker->moveToThread(ptr_parser_thread);
 
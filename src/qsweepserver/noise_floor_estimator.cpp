@@ -0,0 +1,159 @@
+#include "noise_floor_estimator.h"
+
+#include <algorithm>
+
+void p2_quantile::reset()
+{
+    m_count = 0;
+}
+
+void p2_quantile::add(const float &value, const qreal &p)
+{
+    // first five samples: markers are the sorted samples
+    if(m_count < 5)
+    {
+        m_q[m_count] = value;
+        m_count++;
+
+        if(m_count == 5)
+        {
+            std::sort(m_q, m_q + 5);
+
+            for(int i=0; i<5; ++i)
+                m_n[i] = i;
+        }
+
+        return;
+    }
+
+    int k;
+
+    if(value < m_q[0])
+    {
+        m_q[0] = value;
+        k = 0;
+    }else if(value >= m_q[4]){
+        m_q[4] = value;
+        k = 3;
+    }else{
+        k = 0;
+        while((k < 3)&&(value >= m_q[k+1]))
+            k++;
+    }
+
+    for(int i=k+1; i<5; ++i)
+        m_n[i]++;
+
+    m_count++;
+
+    // desired positions of the middle markers
+    const qreal desired[3] = {
+        (m_count - 1)*p/2,
+        (m_count - 1)*p,
+        (m_count - 1)*(1 + p)/2
+    };
+
+    for(int i=1; i<4; ++i)
+    {
+        const qreal d = desired[i-1] - m_n[i];
+
+        if(((d >= 1)&&(m_n[i+1] - m_n[i] > 1))||((d <= -1)&&(m_n[i-1] - m_n[i] < -1)))
+        {
+            const int s = d > 0 ? 1 : -1;
+
+            // parabolic prediction
+            const qreal q = m_q[i] + static_cast<qreal>(s)/(m_n[i+1] - m_n[i-1])
+                    *((m_n[i] - m_n[i-1] + s)*static_cast<qreal>(m_q[i+1] - m_q[i])/(m_n[i+1] - m_n[i])
+                      + (m_n[i+1] - m_n[i] - s)*static_cast<qreal>(m_q[i] - m_q[i-1])/(m_n[i] - m_n[i-1]));
+
+            if((m_q[i-1] < q)&&(q < m_q[i+1]))
+                m_q[i] = static_cast<float>(q);
+            else    // linear
+                m_q[i] = m_q[i] + s*(m_q[i+s] - m_q[i])/(m_n[i+s] - m_n[i]);
+
+            m_n[i] += s;
+        }
+    }
+}
+
+float p2_quantile::value(const qreal &p) const
+{
+    if(m_count >= 5)
+        return m_q[2];
+
+    if(m_count == 0)
+        return 0;
+
+    float sorted[5];
+    std::copy(m_q, m_q + m_count, sorted);
+    std::sort(sorted, sorted + m_count);
+
+    return sorted[qMin(m_count - 1, static_cast<int>(p*m_count))];
+}
+
+void noise_floor_estimator::set_quantile(const qreal &value)
+{
+    m_quantile = qBound(0.01, value, 0.99);
+}
+
+void noise_floor_estimator::set_window(const qint32 &value)
+{
+    m_window = qMax(5, value);
+}
+
+void noise_floor_estimator::update(const QString &id_params, QVector<power_spectr> &powers)
+{
+    // new sweep params
+    if(id_params != m_id_params)
+    {
+        clear();
+        m_id_params = id_params;
+    }
+
+    for(int s=0; s<powers.size(); ++s)
+    {
+        power_spectr &power = powers[s];
+        segment_state &segment = m_segments[power.hz_low];
+        const int size = power.m_power.size();
+
+        if(segment.m_bins.size() != size)
+        {
+            segment.m_bins.fill(p2_quantile(), size);
+            segment.m_last.clear();
+
+            for(int i=0; i<size; ++i)
+                segment.m_bins[i].reset();
+        }
+
+        p2_quantile *bins = segment.m_bins.data();
+        power.m_noise_floor.resize(size);
+
+        for(int i=0; i<size; ++i)
+        {
+            bins[i].add(static_cast<float>(power.m_power.at(i)), m_quantile);
+
+            if((bins[i].count() < 5)&&(segment.m_last.size() == size))
+                power.m_noise_floor[i] = static_cast<qreal>(segment.m_last.at(i));
+            else
+                power.m_noise_floor[i] = static_cast<qreal>(bins[i].value(m_quantile));
+        }
+
+        // all bins of the segment have the same count
+        if((size > 0)&&(bins[0].count() >= m_window))
+        {
+            segment.m_last.resize(size);
+
+            for(int i=0; i<size; ++i)
+            {
+                segment.m_last[i] = bins[i].value(m_quantile);
+                bins[i].reset();
+            }
+        }
+    }
+}
+
+void noise_floor_estimator::clear()
+{
+    m_segments.clear();
+    m_id_params.clear();
+}
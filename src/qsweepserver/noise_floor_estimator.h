@@ -0,0 +1,53 @@
+#ifndef NOISE_FLOOR_ESTIMATOR_H
+#define NOISE_FLOOR_ESTIMATOR_H
+
+#include <QHash>
+#include <QVector>
+
+#include "data_spectr.h"
+
+// P² running quantile of one bin (Jain & Chlamtac): five markers,
+// O(1) memory and O(1) update, no samples are stored
+class p2_quantile
+{
+public:
+    void reset();
+    void add(const float &value, const qreal &p);
+    float value(const qreal &p)const;
+    qint32 count()const { return m_count; }
+
+private:
+    float m_q[5];           // marker heights
+    qint32 m_n[5];          // marker positions (0 based)
+    qint32 m_count = 0;
+};
+
+// noise floor per bin of every segment of the sweep: P² quantile over
+// the last "window" sweeps (the estimator is restarted, the previous
+// estimate is used until the new one has enough sweeps)
+class noise_floor_estimator
+{
+public:
+    void set_quantile(const qreal &);
+    void set_window(const qint32 &);
+
+    // fills power_spectr::m_noise_floor
+    void update(const QString &id_params, QVector<power_spectr> &powers);
+    void clear();
+
+private:
+    struct segment_state
+    {
+        QVector<p2_quantile> m_bins;
+        QVector<float> m_last;      // estimate of the previous window
+    };
+
+    qreal m_quantile = 0.5;
+    qint32 m_window = 500;
+    QString m_id_params;
+
+    // by segment (hz_low)
+    QHash<quint64, segment_state> m_segments;
+};
+
+#endif // NOISE_FLOOR_ESTIMATOR_H
@@ -10,6 +10,7 @@ include(../../protocol.pri)
 SOURCES += \
     core_sweep.cpp \
     hackrf_info.cpp \
+    noise_floor_estimator.cpp \
     worker/parser_worker.cpp \
     qsweepserver.cpp \
     settings/server_settings.cpp \
@@ -21,6 +22,7 @@ SOURCES += \
 HEADERS += \
     core_sweep.h \
     hackrf_info.h \
+    noise_floor_estimator.h \
     worker/parser_worker.h \
     settings/server_settings.h \
     constant.h \
@@ -10,6 +10,12 @@ static const QString DELAYED_LAUNCH_KEY = QStringLiteral("delayed_launch");
 static const QString ID_KEY = QStringLiteral("id");
 static const QString SPECTRUM_NATIVE_KEY = QStringLiteral("spectrum_source_native");
 static const QString SPECTRUM_PROCESS_NAME_KEY = QStringLiteral("spectrum_process_name");
+static const QString NOISE_FLOOR_KEY = QStringLiteral("noise_floor");
+static const QString NOISE_FLOOR_QUANTILE_KEY = QStringLiteral("noise_floor_quantile");
+static const QString NOISE_FLOOR_WINDOW_KEY = QStringLiteral("noise_floor_window");
+static const QString SPARSE_UPDATE_KEY = QStringLiteral("sparse_update");
+static const QString SPARSE_THRESHOLD_KEY = QStringLiteral("sparse_threshold");
+static const QString SPARSE_REFRESH_KEY = QStringLiteral("sparse_refresh");
 
 class server_settings_data : public QSharedData {
 public:
@@ -23,6 +29,12 @@ public:
         id = "unknow";
         spectrum_source_native = true;
         spectrum_process_name.clear();
+        noise_floor = false;
+        noise_floor_quantile = 0.5;
+        noise_floor_window = 500;
+        sparse_update = false;
+        sparse_threshold = 1.0;
+        sparse_refresh = 20;
     }
     server_settings_data(const server_settings_data &other) : QSharedData(other)
     {
@@ -34,6 +46,12 @@ public:
         id = other.id;
         spectrum_source_native = other.spectrum_source_native;
         spectrum_process_name = other.spectrum_process_name;
+        noise_floor = other.noise_floor;
+        noise_floor_quantile = other.noise_floor_quantile;
+        noise_floor_window = other.noise_floor_window;
+        sparse_update = other.sparse_update;
+        sparse_threshold = other.sparse_threshold;
+        sparse_refresh = other.sparse_refresh;
     }
 
     ~server_settings_data() {}
@@ -46,6 +64,12 @@ public:
     QString id;
     bool spectrum_source_native;
     QString spectrum_process_name;
+    bool noise_floor;
+    qreal noise_floor_quantile;
+    int noise_floor_window;
+    bool sparse_update;
+    qreal sparse_threshold;
+    int sparse_refresh;
 };
 
 server_settings::server_settings() : data(new server_settings_data)
@@ -70,6 +94,12 @@ server_settings::server_settings(const QByteArray &json) : data(new server_setti
     data->id = json_object.value(ID_KEY).toString();
     data->spectrum_source_native = json_object.value(SPECTRUM_NATIVE_KEY).toBool();
     data->spectrum_process_name = json_object.value(SPECTRUM_PROCESS_NAME_KEY).toString();
+    data->noise_floor = json_object.value(NOISE_FLOOR_KEY).toBool(false);
+    data->noise_floor_quantile = json_object.value(NOISE_FLOOR_QUANTILE_KEY).toDouble(0.5);
+    data->noise_floor_window = json_object.value(NOISE_FLOOR_WINDOW_KEY).toInt(500);
+    data->sparse_update = json_object.value(SPARSE_UPDATE_KEY).toBool(false);
+    data->sparse_threshold = json_object.value(SPARSE_THRESHOLD_KEY).toDouble(1.0);
+    data->sparse_refresh = json_object.value(SPARSE_REFRESH_KEY).toInt(20);
 
     if(!doc.isEmpty())
         data->valid = true;
@@ -154,6 +184,66 @@ QString server_settings::spectrum_process_name() const
     return data->spectrum_process_name;
 }
 
+void server_settings::set_noise_floor(const bool &value)
+{
+    data->noise_floor = value;
+}
+
+bool server_settings::noise_floor() const
+{
+    return data->noise_floor;
+}
+
+void server_settings::set_noise_floor_quantile(const qreal &value)
+{
+    data->noise_floor_quantile = value;
+}
+
+qreal server_settings::noise_floor_quantile() const
+{
+    return data->noise_floor_quantile;
+}
+
+void server_settings::set_noise_floor_window(const int &value)
+{
+    data->noise_floor_window = value;
+}
+
+int server_settings::noise_floor_window() const
+{
+    return data->noise_floor_window;
+}
+
+void server_settings::set_sparse_update(const bool &value)
+{
+    data->sparse_update = value;
+}
+
+bool server_settings::sparse_update() const
+{
+    return data->sparse_update;
+}
+
+void server_settings::set_sparse_threshold(const qreal &value)
+{
+    data->sparse_threshold = value;
+}
+
+qreal server_settings::sparse_threshold() const
+{
+    return data->sparse_threshold;
+}
+
+void server_settings::set_sparse_refresh(const int &value)
+{
+    data->sparse_refresh = value;
+}
+
+int server_settings::sparse_refresh() const
+{
+    return data->sparse_refresh;
+}
+
 void server_settings::set_id(const QString &value)
 {
     data->id = value;
@@ -174,6 +264,12 @@ QByteArray server_settings::to_json() const
     json_object.insert(ID_KEY, data->id);
     json_object.insert(SPECTRUM_NATIVE_KEY, data->spectrum_source_native);
     json_object.insert(SPECTRUM_PROCESS_NAME_KEY, data->spectrum_process_name);
+    json_object.insert(NOISE_FLOOR_KEY, data->noise_floor);
+    json_object.insert(NOISE_FLOOR_QUANTILE_KEY, data->noise_floor_quantile);
+    json_object.insert(NOISE_FLOOR_WINDOW_KEY, data->noise_floor_window);
+    json_object.insert(SPARSE_UPDATE_KEY, data->sparse_update);
+    json_object.insert(SPARSE_THRESHOLD_KEY, data->sparse_threshold);
+    json_object.insert(SPARSE_REFRESH_KEY, data->sparse_refresh);
 
     QJsonDocument doc(json_object);
 
@@ -35,6 +35,24 @@ public:
     void set_spectrum_process_name(const QString &);
     QString spectrum_process_name()const;
 
+    void set_noise_floor(const bool &);
+    bool noise_floor()const;
+
+    void set_noise_floor_quantile(const qreal &);
+    qreal noise_floor_quantile()const;
+
+    void set_noise_floor_window(const int &);
+    int noise_floor_window()const;
+
+    void set_sparse_update(const bool &);
+    bool sparse_update()const;
+
+    void set_sparse_threshold(const qreal &);
+    qreal sparse_threshold()const;
+
+    void set_sparse_refresh(const int &);
+    int sparse_refresh()const;
+
     void set_id(const QString &);
     QString id()const;
 
@@ -20,6 +20,20 @@ parser_worker::parser_worker(QObject *parent) : QObject(parent),
 
 }
 
+void parser_worker::set_noise_floor(const qreal &quantile, const qint32 &window)
+{
+    m_noise_floor.set_quantile(quantile);
+    m_noise_floor.set_window(window);
+    is_noise_floor = true;
+}
+
+void parser_worker::set_sparse_update(const qreal &threshold, const qint32 &refresh)
+{
+    m_sparse_encoder.set_threshold(threshold);
+    m_sparse_encoder.set_refresh(refresh);
+    is_sparse_update = true;
+}
+
 void parser_worker::slot_input_line(const QByteArray &line)
 {
     const auto list_ba_data(line.split(','));
@@ -60,11 +74,19 @@ void parser_worker::slot_input_line(const QByteArray &line)
                     sweep_message send_data;
                     send_data.set_type(type_message::data_spectr);
 
+                    if(is_noise_floor)
+                        m_noise_floor.update(id_params_str, buffer_power_db);
+
                     data_spectr spectr;
                     spectr.set_id_params(id_params_str);
                     spectr.set_spectr(buffer_power_db);
 
+                    if(is_sparse_update)
+                        spectr = m_sparse_encoder.encode(spectr);
+
                     send_data.set_data_message(spectr.to_json());
+                    // writers route by params id and first segment
+                    send_data.set_route(id_params_str, buffer_power_db.first().hz_low);
 
                     emit signal_data_spectr_message(send_data.to_json());
 
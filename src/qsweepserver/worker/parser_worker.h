@@ -4,6 +4,8 @@
 #include <QObject>
 
 #include "data_spectr.h"
+#include "noise_floor_estimator.h"
+#include "spectr_sparse.h"
 
 class parser_worker : public QObject
 {
@@ -11,6 +13,12 @@ class parser_worker : public QObject
 public:
     explicit parser_worker(QObject *parent = nullptr);
 
+    // add noise floor series to data_spectr
+    void set_noise_floor(const qreal &quantile, const qint32 &window);
+
+    // publish only changed bins, see spectr_sparse.h
+    void set_sparse_update(const qreal &threshold, const qint32 &refresh);
+
 public slots:
     void slot_input_line(const QByteArray &);
     void slot_run_parser_worker(const QByteArray &);
@@ -28,6 +36,10 @@ private:
     quint64 hz_low_run_process;
     quint64 hz_high_run_process;
     QString id_params_str;
+    bool is_noise_floor {false};
+    noise_floor_estimator m_noise_floor;
+    bool is_sparse_update {false};
+    sparse_encoder m_sparse_encoder;
 };
 
 #endif // SWEEP_PARSER_WORKER_H
@@ -71,11 +71,20 @@ void spectrum_native_worker::onDataPowerSpectrCallbacks(const power_spectr &powe
         sweep_message send_data;
         send_data.set_type(type_message::data_spectr);
 
+        if(is_noise_floor)
+            m_noise_floor.update(QString(params_id_str), m_powerSpectrBuffer);
+
         data_spectr spectr;
         spectr.set_id_params(params_id_str);
         spectr.set_spectr(m_powerSpectrBuffer);
 
+        if(is_sparse_update)
+            spectr = m_sparse_encoder.encode(spectr);
+
         send_data.set_data_message(spectr.to_json());
+        // writers route by params id and first segment
+        if(!m_powerSpectrBuffer.isEmpty())
+            send_data.set_route(QString(params_id_str), m_powerSpectrBuffer.first().hz_low);
 
         emit signal_sweep_message(send_data.to_json());
 
@@ -83,6 +92,20 @@ void spectrum_native_worker::onDataPowerSpectrCallbacks(const power_spectr &powe
     }
 }
 
+void spectrum_native_worker::set_noise_floor(const qreal &quantile, const qint32 &window)
+{
+    m_noise_floor.set_quantile(quantile);
+    m_noise_floor.set_window(window);
+    is_noise_floor = true;
+}
+
+void spectrum_native_worker::set_sparse_update(const qreal &threshold, const qint32 &refresh)
+{
+    m_sparse_encoder.set_threshold(threshold);
+    m_sparse_encoder.set_refresh(refresh);
+    is_sparse_update = true;
+}
+
 int spectrum_native_worker::rx_callback(hackrf_transfer *transfer)
 {
     spectrum_native_worker *obj = (spectrum_native_worker *)transfer->rx_ctx;
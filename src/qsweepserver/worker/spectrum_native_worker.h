@@ -14,6 +14,8 @@
 
 #include "constant.h"
 #include "data_spectr.h"
+#include "noise_floor_estimator.h"
+#include "spectr_sparse.h"
 
 class spectrum_native_worker : public QObject
 {
@@ -24,6 +26,12 @@ public:
 
     void onDataPowerSpectrCallbacks(const power_spectr &, const bool &isSending = false);
 
+    // add noise floor series to data_spectr
+    void set_noise_floor(const qreal &quantile, const qint32 &window);
+
+    // publish only changed bins, see spectr_sparse.h
+    void set_sparse_update(const qreal &threshold, const qint32 &refresh);
+
 public slots:
     void slot_run_sweep_worker(const QByteArray &value);
     void slot_stop_sweep_worker();
@@ -49,6 +57,10 @@ private:
 
     hackrf_device* device = nullptr;
     QVector<power_spectr> m_powerSpectrBuffer;
+    bool is_noise_floor {false};
+    noise_floor_estimator m_noise_floor;
+    bool is_sparse_update {false};
+    sparse_encoder m_sparse_encoder;
 
     static int rx_callback(hackrf_transfer *transfer);
     int hackrf_rx_callback(unsigned char *buffer, uint32_t length);
@@ -0,0 +1,203 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTemporaryDir>
+#include <QScopedPointer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDateTime>
+
+#include "sweep_write_settings.h"
+#include "data_spectr.h"
+#include "params_spectr.h"
+#include "database/db_const.h"
+#include "database/db_cleaner_workers.h"
+#include "database/storage_backend.h"
+
+// Soak test of chunk rotation: the writer storage fills a chunk, closes it and
+// the cleaner recycles it, the same path db_writer/db_cleaner take on rotation.
+// RSS is printed every "report" rotations. It is recorded after "warmup"
+// rotations and at the end; the exit code is 2 if it grew by more than
+// "max-growth" kB (leak), 1 on a storage error, 0 otherwise.
+//
+// Build with the project (qsweep.pro) or alone:
+//   qmake soak_chunk_rotation.pro && make
+// Run (binary in bin/):
+//   soak_chunk_rotation --rotations 5000 --storage sqlite
+//   soak_chunk_rotation --rotations 5000 --storage spectr_log
+
+static const QString soak_params_id("soak");
+static const QString soak_connection("soak_writer");
+
+// resident set size (kB), -1 if not available
+static qint64 rss_kb()
+{
+    QFile file("/proc/self/status");
+
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+
+    while(!file.atEnd())
+    {
+        const QByteArray line = file.readLine();
+
+        if(line.startsWith("VmRSS:"))
+            return line.mid(6).trimmed().split(' ').first().toLongLong();
+    }
+
+    return -1;
+}
+
+static data_spectr make_sweep(const int &segments, const int &bins)
+{
+    QVector<power_spectr> powers;
+
+    for(int s=0; s<segments; ++s)
+    {
+        power_spectr power;
+        power.m_date_time = QDateTime::currentDateTimeUtc();
+        power.m_fft_bin_width = 250000;
+        power.hz_low = 100000000 + static_cast<quint64>(s)*5000000;
+        power.hz_high = power.hz_low + 5000000;
+
+        for(int i=0; i<bins; ++i)
+            power.m_power.append(-100 + (i*7 + s*13)%60);
+
+        powers.append(power);
+    }
+
+    data_spectr sweep;
+    sweep.set_id_params(soak_params_id);
+    sweep.set_spectr(powers);
+
+    return sweep;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("soak_chunk_rotation");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Chunk rotation soak test (db writer storage + db cleaner), prints RSS");
+    parser.addHelpOption();
+
+    QCommandLineOption rotations_option("rotations", "Chunk rotations (default 5000).", "count", "5000");
+    QCommandLineOption chunks_option("chunks", "Chunk files (default 4).", "count", "4");
+    QCommandLineOption sweeps_option("sweeps", "Sweeps written per chunk (default 20).", "count", "20");
+    QCommandLineOption report_option("report", "Print RSS every N rotations (default 500).", "count", "500");
+    QCommandLineOption warmup_option("warmup", "Rotations before the RSS baseline (default 500).", "count", "500");
+    QCommandLineOption growth_option("max-growth", "Allowed RSS growth after warm-up, kB (default 2048).", "kB", "2048");
+    QCommandLineOption storage_option("storage", "Chunk storage: sqlite or spectr_log (default sqlite).", "type", "sqlite");
+    QCommandLineOption path_option("path", "Chunk directory (default: temporary).", "path");
+
+    parser.addOption(rotations_option);
+    parser.addOption(chunks_option);
+    parser.addOption(sweeps_option);
+    parser.addOption(report_option);
+    parser.addOption(warmup_option);
+    parser.addOption(growth_option);
+    parser.addOption(storage_option);
+    parser.addOption(path_option);
+    parser.process(app);
+
+    const int rotations = qMax(1, parser.value(rotations_option).toInt());
+    const int chunks = qMax(1, parser.value(chunks_option).toInt());
+    const int sweeps = qMax(1, parser.value(sweeps_option).toInt());
+    const int report = qMax(1, parser.value(report_option).toInt());
+    const int warmup = qBound(0, parser.value(warmup_option).toInt(), rotations - 1);
+    const qint64 max_growth = qMax(static_cast<qint64>(0), parser.value(growth_option).toLongLong());
+    const storage_type storage = (parser.value(storage_option) == "spectr_log")
+            ? storage_type::spectr_log : storage_type::sqlite;
+
+    QTemporaryDir temp_dir;
+    const QString db_path = parser.isSet(path_option) ? parser.value(path_option) : temp_dir.path();
+
+    sweep_write_settings settings;
+    settings.set_db_path(db_path);
+    settings.set_db_file_count(chunks);
+    settings.set_storage(storage);
+
+    const QStringList list_file(list_of_all_chunk_files(db_path, chunks, chunk_file_template(storage)));
+
+    db_cleaner_workers cleaner;
+    cleaner.set_configuration(settings);
+    cleaner.slot_initialization();
+
+    QScopedPointer<storage_backend> ptr_storage(create_storage_backend(storage, soak_connection));
+
+    params_spectr params;
+    params.set_id_params(soak_params_id);
+    params.set_frequency_min(100);
+    params.set_frequency_max(300);
+    params.set_fft_bin_width(250000);
+
+    const data_spectr sweep = make_sweep(40, 20);
+
+    const qint64 rss_start = rss_kb();
+    qint64 rss_max = rss_start;
+    qint64 rss_warmup = rss_start;
+
+    fprintf(stdout, "storage: %s, chunks: %d, sweeps per chunk: %d, path: %s\n",
+            qUtf8Printable(parser.value(storage_option)), chunks, sweeps, qUtf8Printable(db_path));
+    fprintf(stdout, "rotation 0: rss %lld kB\n", rss_start);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(int r=1; r<=rotations; ++r)
+    {
+        const QString &file_name = list_file.at((r - 1)%list_file.size());
+
+        if(!ptr_storage->open(file_name))
+        {
+            fprintf(stderr, "Can't open chunk %s: %s\n", qUtf8Printable(file_name),
+                    qUtf8Printable(ptr_storage->last_error()));
+            return 1;
+        }
+
+        ptr_storage->write_params(params);
+
+        for(int s=0; s<sweeps; ++s)
+            ptr_storage->write_spectr(sweep);
+
+        ptr_storage->close();
+
+        // backed up chunk goes back to the writer empty
+        cleaner.slot_clean_db(file_name);
+
+        if(r == warmup)
+            rss_warmup = rss_kb();
+
+        if(r%report == 0)
+        {
+            const qint64 rss = rss_kb();
+            rss_max = qMax(rss_max, rss);
+
+            fprintf(stdout, "rotation %d: rss %lld kB (%+lld kB), %lld ms\n",
+                    r, rss, rss - rss_start, timer.elapsed());
+            fflush(stdout);
+        }
+    }
+
+    const qint64 rss_end = rss_kb();
+    const qint64 growth = rss_end - rss_warmup;
+
+    fprintf(stdout, "done: rss max %lld kB, after warm-up (%d rotations) %lld kB, end %lld kB (%+lld kB)\n",
+            qMax(rss_max, rss_end), warmup, rss_warmup, rss_end, growth);
+
+    if((rss_end < 0)||(rss_warmup < 0))
+    {
+        fprintf(stdout, "RSS is not available (/proc/self/status), growth is not checked\n");
+        return 0;
+    }
+
+    if(growth > max_growth)
+    {
+        fprintf(stderr, "FAIL: RSS grew by %lld kB after warm-up (max %lld kB)\n", growth, max_growth);
+        return 2;
+    }
+
+    fprintf(stdout, "PASS: RSS growth %lld kB (max %lld kB)\n", growth, max_growth);
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+QT -= gui
+QT += sql concurrent
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = soak_chunk_rotation
+
+include(../../../../common.pri)
+include(../../../../protocol.pri)
+
+# chunk rotation soak: db writer storage + db cleaner recycling, RSS per N rotations.
+# Built by qsweep.pro; run: bin/soak_chunk_rotation [--rotations N] [--storage sqlite|spectr_log],
+# exit code 2 if RSS grows by more than --max-growth kB after --warmup rotations
+INCLUDEPATH += \
+    ../.. \
+    ../../database
+
+SOURCES += \
+    main.cpp \
+    ../../sweep_write_settings.cpp \
+    ../../database/db_cleaner_workers.cpp \
+    ../../database/db_const.cpp \
+    ../../database/db_custom_workers.cpp \
+    ../../database/db_statement.cpp \
+    ../../database/sqlite_storage.cpp \
+    ../../database/spectr_log_reader.cpp \
+    ../../database/spectr_log_storage.cpp \
+    ../../database/storage_backend.cpp
+
+HEADERS += \
+    ../../sweep_write_settings.h \
+    ../../database/db_cleaner_workers.h \
+    ../../database/db_const.h \
+    ../../database/db_custom_workers.h \
+    ../../database/db_statement.h \
+    ../../database/sqlite_storage.h \
+    ../../database/spectr_log_reader.h \
+    ../../database/spectr_log_storage.h \
+    ../../database/storage_backend.h
@@ -1,5 +1,6 @@
 #include "core_sweep_write.h"
 
+#include <QCoreApplication>
 #include <QFileInfo>
 #include <QDir>
 
@@ -17,6 +18,9 @@ core_sweep_write::core_sweep_write(const QString &file, QObject *parent) : QObje
     {
         initialization();
         launching();
+
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                this, &core_sweep_write::slot_stopping);
     } else {
         qCritical("Error: Read settings.");
     }
@@ -37,6 +41,14 @@ void core_sweep_write::initialization()
     // connect signals and slots
     connect(ptr_mqtt_provider, &mqtt_provider::signal_received_data,
             ptr_db_manager, &db_manager::slot_received_data);
+    // db reader: request and result
+    connect(ptr_mqtt_provider, &mqtt_provider::signal_reader_ctrl,
+            ptr_db_manager, &db_manager::slot_reader_ctrl);
+    connect(ptr_db_manager, &db_manager::signal_publish_message,
+            ptr_mqtt_provider, &mqtt_provider::slot_publish_message);
+    // detected events
+    connect(ptr_db_manager, &db_manager::signal_publish_event,
+            ptr_mqtt_provider, &mqtt_provider::slot_publish_event);
 }
 
 void core_sweep_write::launching()
@@ -44,6 +56,15 @@ void core_sweep_write::launching()
     ptr_mqtt_provider->launching();
 }
 
+void core_sweep_write::slot_stopping()
+{
+    // last messages of the workers (event stop), then disconnect
+    ptr_db_manager->stopping();
+    QCoreApplication::sendPostedEvents();
+
+    ptr_mqtt_provider->stopping();
+}
+
 bool core_sweep_write::save_settings(const QString &file)
 {
     bool is_save(false);
@@ -18,6 +18,9 @@ signals:
 
 public slots:
 
+private slots:
+    void slot_stopping();
+
 private:
     sweep_write_settings m_sweep_write_settings;
     mqtt_provider *ptr_mqtt_provider {Q_NULLPTR};
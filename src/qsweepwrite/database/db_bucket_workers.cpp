@@ -0,0 +1,63 @@
+#include "db_bucket_workers.h"
+#include "db_const.h"
+
+#include <QTimer>
+#include <QDateTime>
+
+bool spectr_bucket::is_same_layout(const quint64 &hz_low, const quint64 &hz_high, const int &size) const
+{
+    return (m_hz_low == hz_low)&&(m_hz_high == hz_high)&&(m_size == size);
+}
+
+bool spectr_bucket::is_stale(const qint64 &start, const quint64 &hz_low, const quint64 &hz_high,
+                             const int &size) const
+{
+    return (!is_empty())&&((m_start != start)||(!is_same_layout(hz_low, hz_high, size)));
+}
+
+void spectr_bucket::reset_layout(const QString &params_id, const qint64 &start, const quint64 &hz_low,
+                                 const quint64 &hz_high, const qreal &fft_bin_width, const int &size)
+{
+    m_params_id = params_id;
+    m_start = start;
+    m_hz_low = hz_low;
+    m_hz_high = hz_high;
+    m_fft_bin_width = fft_bin_width;
+    m_count = 0;
+    m_size = size;
+}
+
+db_bucket_workers::db_bucket_workers(QObject *parent) : db_custom_workers(parent)
+{
+
+}
+
+void db_bucket_workers::slot_timeout()
+{
+    flush_expired(QDateTime::currentMSecsSinceEpoch());
+
+    if(is_open_db())
+        apply_retention();
+}
+
+void db_bucket_workers::start_flush_timer(const qint64 &interval)
+{
+    if(!ptr_timer)
+    {
+        ptr_timer = new QTimer(this);
+        connect(ptr_timer, &QTimer::timeout,
+                this, &db_bucket_workers::slot_timeout);
+    }
+
+    ptr_timer->start(static_cast<int>(interval));
+}
+
+void db_bucket_workers::delete_before(const QString &table_name, const qint64 &time)
+{
+    QSqlQuery query(m_dbase);
+    query.prepare(delete_before_sql(table_name, "dt_start"));
+    query.bindValue(":value", time);
+
+    if(!query.exec())
+        update_last_error(&query);
+}
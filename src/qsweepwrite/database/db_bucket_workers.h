@@ -0,0 +1,54 @@
+#ifndef DB_BUCKET_WORKERS_H
+#define DB_BUCKET_WORKERS_H
+
+#include <QMap>
+
+#include "db_custom_workers.h"
+#include "spectr_frame.h"
+#include "data_spectr.h"
+
+class QTimer;
+
+// time bucket of one params_id (layout and sweep count),
+// the statistics per bin are kept by the derived buckets
+struct spectr_bucket
+{
+    QString m_params_id;
+    qint64 m_start = 0;         // ms since epoch (UTC)
+    quint64 m_hz_low = 0;
+    quint64 m_hz_high = 0;
+    qreal m_fft_bin_width = 0;
+    qint64 m_count = 0;         // sweeps
+    int m_size = 0;             // bins
+
+    bool is_empty()const { return m_count == 0; }
+    bool is_same_layout(const quint64 &hz_low, const quint64 &hz_high, const int &size)const;
+    // not empty and of another window or layout: flushed before new data
+    bool is_stale(const qint64 &start, const quint64 &hz_low, const quint64 &hz_high, const int &size)const;
+    void reset_layout(const QString &params_id, const qint64 &start, const quint64 &hz_low,
+                      const quint64 &hz_high, const qreal &fft_bin_width, const int &size);
+};
+
+// workers writing time buckets: flush timer of buckets without new sweeps, retention
+class db_bucket_workers : public db_custom_workers
+{
+    Q_OBJECT
+public:
+    explicit db_bucket_workers(QObject *parent = nullptr);
+
+private slots:
+    void slot_timeout();
+
+protected:
+    void start_flush_timer(const qint64 &interval);
+    void delete_before(const QString &table_name, const qint64 &time);
+
+    // buckets ended before "now" are written
+    virtual void flush_expired(const qint64 &now) = 0;
+    virtual void apply_retention() = 0;
+
+private:
+    QTimer *ptr_timer {Q_NULLPTR};
+};
+
+#endif // DB_BUCKET_WORKERS_H
@@ -1,8 +1,9 @@
 #include "db_cleaner_workers.h"
 #include "database/db_const.h"
+#include "spectr_log_storage.h"
 
 #include <QFileInfo>
-#include <QTimer>
+#include <QElapsedTimer>
 #include <QTime>
 
 #ifdef QT_DEBUG
@@ -16,68 +17,139 @@ db_cleaner_workers::db_cleaner_workers(QObject *parent) : db_custom_workers(pare
     m_dbase = QSqlDatabase::addDatabase(database_driver, connection_delete);
 }
 
+void db_cleaner_workers::slot_initialization()
+{
+    const QString template_name = chunk_template_file(m_settings.storage());
+
+    if(m_settings.db_path().isEmpty())
+        m_template_name = template_name;
+    else
+        m_template_name = m_settings.db_path() + QDir::separator() + template_name;
+
+    if(!create_template_db())
+    {
+#ifdef QT_DEBUG
+        qCritical() << "Can't create template database:" << m_template_name;
+#endif
+        m_template_name.clear();
+    }
+
+    emit signal_update_state_workers(state_workers::initialization);
+}
+
 void db_cleaner_workers::slot_clean_db(const QString &file_name)
 {
     QFileInfo file_db(file_name);
 
     if(file_db.exists())
     {
-        open_db(file_name);
+        QElapsedTimer start_time;
+        start_time.start();
+
+#ifdef QT_DEBUG
+        qDebug() << "start clean database:" << QTime::currentTime().toString();
+        qDebug() << "database:" << file_name;
+#endif
+
+        // O(1): replace the chunk with the empty template,
+        // fallback: drop and create tables (no VACUUM) or empty segment
+        bool is_recycled = recycle_from_template(file_name);
 
-        if(is_open_db())
+        if(!is_recycled)
         {
-            const auto list_table = table.keys();
+            if(m_settings.storage() == storage_type::spectr_log)
+                is_recycled = spectr_log_storage::create_empty(file_name);
+            else
+                is_recycled = recycle_drop_tables(file_name);
+        }
 
-            QTimer start_time;
-            start_time.start();
+        const qint64 elapsed = start_time.elapsed();
 
 #ifdef QT_DEBUG
-            qDebug() << "start clean database:" << QTime::currentTime().toString();
-            qDebug() << "database:" << file_name;
+        qDebug() << "stop clean database:" << QTime::currentTime().toString()
+                 << QString("Time elapsed: %1 ms").arg(elapsed);
 #endif
 
-            for(int i=0; i<list_table.size(); ++i)
-            {
-                if(is_table_name_resolve(list_table.at(i)))
-                {
-#ifdef QT_DEBUG
-                    qDebug() << "delete from table:" << list_table.at(i);
-#endif
-                    QSqlQuery* query_delete = new QSqlQuery(m_dbase);
-                    //query_delete->prepare(delete_table_sql(list_table.at(i)));
-
-                    if(query_delete->exec(delete_table_sql(list_table.at(i))))
-                        update_size_file(m_dbase.databaseName());
-                    else
-                        update_last_error(query_delete);
-                }
-            }
+        if(is_recycled)
+        {
+            update_size_file(file_name);
 
-            close_db();
+            emit signal_recycle_time(file_name, elapsed);
+            emit signal_state_db(file_name, state_db::file_is_ready);
+        }
+    }
+}
 
-            // VACUUM
-            open_db(file_name);
+bool db_cleaner_workers::create_template_db()
+{
+    if(QFile::exists(m_template_name))
+        QFile::remove(m_template_name);
 
-            if(is_open_db())
-            {
-                // VACUUM
-                QSqlQuery* query_vacuum = new QSqlQuery(m_dbase);
-                query_vacuum->prepare("VACUUM");
+    if(m_settings.storage() == storage_type::spectr_log)
+        return spectr_log_storage::create_empty(m_template_name);
 
-                if(query_vacuum->exec())
-                    update_size_file(m_dbase.databaseName());
-                else
-                    update_last_error(query_vacuum);
+    open_db(m_template_name);
 
-                close_db();
-            }
+    bool is_created(is_open_db());
 
-#ifdef QT_DEBUG
-            qDebug() << "stop clean database:" << QTime::currentTime().toString()
-                     << QString("Time elapsed: %1 ms").arg(start_time.interval());
-#endif
+    if(is_created)
+    {
+        // auto_vacuum must be set before the first table is created
+        set_pragma("auto_vacuum", "1");
 
-            emit signal_state_db(file_name, state_db::file_is_ready);
+        const auto list_table = table.keys();
+
+        for(int i=0; i<list_table.size(); ++i)
+            is_created = create_table(list_table.at(i)) && is_created;
+
+        close_db();
+    }
+
+    return is_created;
+}
+
+bool db_cleaner_workers::recycle_from_template(const QString &file_name)
+{
+    if(m_template_name.isEmpty()||(!QFile::exists(m_template_name)))
+        return false;
+
+    // stale rollback journal would be applied to the new file
+    QFile::remove(file_name + "-journal");
+
+    if(!QFile::remove(file_name))
+        return false;
+
+    return QFile::copy(m_template_name, file_name);
+}
+
+bool db_cleaner_workers::recycle_drop_tables(const QString &file_name)
+{
+    open_db(file_name);
+
+    bool is_recycled(is_open_db());
+
+    if(is_recycled)
+    {
+        const auto list_table = table.keys();
+
+        start_transaction();
+
+        for(int i=0; i<list_table.size(); ++i)
+        {
+            QSqlQuery query_drop(m_dbase);
+
+            if(!query_drop.exec(drop_table_sql(list_table.at(i))))
+            {
+                update_last_error(&query_drop);
+                is_recycled = false;
+            }
+
+            is_recycled = create_table(list_table.at(i)) && is_recycled;
         }
+
+        commit_transaction();
+        close_db();
     }
+
+    return is_recycled;
 }
@@ -10,8 +10,18 @@ public:
     explicit db_cleaner_workers(QObject *parent = nullptr);
 
 public slots:
+    void slot_initialization() Q_DECL_OVERRIDE;
     void slot_clean_db(const QString &);
 
+signals:
+    void signal_recycle_time(const QString &, const qint64 &);
+
+private:
+    QString m_template_name;
+
+    bool create_template_db();
+    bool recycle_from_template(const QString &);
+    bool recycle_drop_tables(const QString &);
 };
 
 #endif // DB_CLEANER_WORKERS_H
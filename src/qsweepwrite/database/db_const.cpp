@@ -1,19 +1,42 @@
 #include "db_const.h"
 
-QStringList list_of_all_chunk_files(const QString &db_path, const qint32 &db_file_count)
+#include <QHash>
+#include <QElapsedTimer>
+#include <QtEndian>
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
+
+QString chunk_file_template(const storage_type &type)
+{
+    if(type == storage_type::spectr_log)
+        return result_log_name;
+
+    return result_database_name;
+}
+
+QString chunk_template_file(const storage_type &type)
+{
+    if(type == storage_type::spectr_log)
+        return template_log_name;
+
+    return template_database_name;
+}
+
+QStringList list_of_all_chunk_files(const QString &db_path, const qint32 &db_file_count,
+                                    const QString &file_template)
 {
     QStringList list_chunk;
 
     if((!db_path.isEmpty())&&(db_file_count>0)){
         for(int i=0; i<db_file_count; ++i ){
-            QString file = db_path + QDir::separator() + result_database_name.arg(i+1);
+            QString file = db_path + QDir::separator() + file_template.arg(i+1);
             list_chunk.append(file);
         }
     }
 
     if((db_path.isEmpty())&&(db_file_count>0)){
         for(int i=0; i<db_file_count; ++i ){
-            QString file = result_database_name.arg(i+1);
+            QString file = file_template.arg(i+1);
             list_chunk.append(file);
         }
     }
@@ -31,19 +54,24 @@ QString pragma_sql(const QString &param, const QString &value)
     return pragma_string;
 }
 
+QMap<QString, QString> table_columns(const QString &table_name)
+{
+    if(table.contains(table_name))
+        return table.value(table_name);
+
+    if(rollup_table.contains(table_name))
+        return rollup_table.value(table_name);
+
+    return stat_table.value(table_name);
+}
+
 QString list_column_and_type(const QString &table_name)
 {
     QStringList list;
-    QMap<QString, QString> tmp_column = table.value(table_name);
+    const QMap<QString, QString> tmp_column = table_columns(table_name);
 
-    for(int i=0; i<tmp_column.keys().size(); i++)
-    {
-        QString tmp;
-        tmp.append(tmp_column.keys().at(i));
-        tmp.append(" ");
-        tmp.append(tmp_column.value(tmp_column.keys().at(i)));
-        list.append(tmp);
-    }
+    for(auto it = tmp_column.constBegin(); it != tmp_column.constEnd(); ++it)
+        list.append(it.key() + " " + it.value());
 
     return list.join(",");
 }
@@ -51,73 +79,219 @@ QString list_column_and_type(const QString &table_name)
 QString list_column_prefix(const QString &table_name, const QString &prefix)
 {
     QStringList list;
-    QMap<QString, QString> tmp_column = table.value(table_name);
+    const QMap<QString, QString> tmp_column = table_columns(table_name);
 
-    for(int i=0; i<tmp_column.keys().size(); ++i)
-    {
-        QString tmp;
+    for(auto it = tmp_column.constBegin(); it != tmp_column.constEnd(); ++it)
+        list.append(prefix + it.key());
 
-        if(!prefix.isEmpty())
-            tmp.append(prefix);
+    return list.join(",");
+}
 
-        tmp.append(tmp_column.keys().at(i));
+static table_schema build_schema(const QString &table_name, const QMap<QString, QString> &columns)
+{
+    table_schema schema;
+    schema.m_name = table_name;
+
+    QStringList column_and_type;
+    QStringList insert_named;
+    QStringList insert_positional;
 
-        list.append(tmp);
+    for(auto it = columns.constBegin(); it != columns.constEnd(); ++it)
+    {
+        schema.m_columns.append(it.key());
+        column_and_type.append(it.key() + " " + it.value());
+
+        if(it.value() != sqlite_type_integer_pk)
+        {
+            schema.m_insert_columns.append(it.key());
+            insert_named.append(":" + it.key());
+            insert_positional.append("?");
+        }
     }
 
-    return list.join(",");
+    QStringList str_create_table;
+    str_create_table << "CREATE TABLE"
+                     << table_name
+                     << "(" << column_and_type.join(",") << ");";
+
+    schema.m_create_sql = str_create_table.join(" ");
+
+    QStringList str_insert_table;
+    str_insert_table << "INSERT INTO"
+                     << table_name
+                     << "(" << schema.m_insert_columns.join(",") << ")"
+                     << "VALUES";
+
+    schema.m_insert_sql = (QStringList(str_insert_table) << "(" << insert_positional.join(",") << ");").join(" ");
+    schema.m_insert_named_sql = (QStringList(str_insert_table) << "(" << insert_named.join(",") << ");").join(" ");
+
+    return schema;
+}
+
+static QHash<QString, table_schema> build_all_schema()
+{
+    QHash<QString, table_schema> all_schema;
+
+    for(const auto &tables : {table, rollup_table, stat_table})
+        for(auto it = tables.constBegin(); it != tables.constEnd(); ++it)
+            all_schema.insert(it.key(), build_schema(it.key(), it.value()));
+
+    return all_schema;
+}
+
+const table_schema &schema_of(const QString &table_name)
+{
+    // built once (thread safe static init), read only afterwards
+    static const QHash<QString, table_schema> all_schema = build_all_schema();
+    static const table_schema empty_schema;
+
+    const auto it = all_schema.constFind(table_name);
+
+    return it != all_schema.constEnd() ? it.value() : empty_schema;
 }
 
 QString create_table_sql(const QString &table_name)
+{
+    return schema_of(table_name).m_create_sql;
+}
+
+QString insert_table_sql(const QString &table_name)
+{
+    return schema_of(table_name).m_insert_named_sql;
+}
+
+QString delete_table_sql(const QString &table_name)
 {
     QString sql;
 
-    if((!table_name.isEmpty()&&(!table.value(table_name).isEmpty())))
-    {
-        QStringList str_create_table;
+    QStringList str_delete_table;
 
-        str_create_table << "CREATE TABLE"
-                         << table_name
-                         << "(" << list_column_and_type(table_name) << ");";
+    str_delete_table << "DELETE FROM"
+                     << table_name
+                     << ";";
 
-        sql.append(str_create_table.join(" "));
-    }
+    sql.append(str_delete_table.join(" "));
 
     return sql;
 }
 
-QString insert_table_sql(const QString &table_name)
+QString drop_table_sql(const QString &table_name)
 {
     QString sql;
 
-    QStringList str_insert_table;
+    QStringList str_drop_table;
 
-    str_insert_table << "INSERT INTO"
-                     << table_name
-                     << "(" << list_column_prefix(table_name, "") << ")"
-                     << "VALUES"
-                     << "(" << list_column_prefix(table_name, ":") << ");";
+    str_drop_table << "DROP TABLE IF EXISTS"
+                   << table_name
+                   << ";";
 
-    sql.append(str_insert_table.join(" "));
+    sql.append(str_drop_table.join(" "));
 
     return sql;
 }
 
-QString delete_table_sql(const QString &table_name)
+QString create_index_sql(const QString &table_name, const QString &column)
 {
     QString sql;
 
-    QStringList str_delete_table;
+    QStringList str_create_index;
 
-    str_delete_table << "DELETE FROM"
+    str_create_index << "CREATE INDEX IF NOT EXISTS"
+                     << QString("%1_%2_idx").arg(table_name).arg(column)
+                     << "ON"
                      << table_name
-                     << ";";
+                     << "(" << column << ");";
 
-    sql.append(str_delete_table.join(" "));
+    sql.append(str_create_index.join(" "));
+
+    return sql;
+}
+
+QString delete_before_sql(const QString &table_name, const QString &column)
+{
+    QString sql;
+
+    QStringList str_delete;
+
+    str_delete << "DELETE FROM"
+               << table_name
+               << "WHERE"
+               << column
+               << "< :value;";
+
+    sql.append(str_delete.join(" "));
 
     return sql;
 }
 
+QString select_range_sql(const QString &table_name, const QString &column, const bool &by_params)
+{
+    QString sql;
+
+    QStringList str_select;
+
+    str_select << "SELECT"
+               << list_column_prefix(table_name, "")
+               << "FROM"
+               << table_name
+               << "WHERE"
+               << column
+               << ">= :from AND"
+               << column
+               << "< :to";
+
+    if(by_params)
+        str_select << "AND params_id = :params_id";
+
+    str_select << "ORDER BY"
+               << column
+               << "LIMIT :limit;";
+
+    sql.append(str_select.join(" "));
+
+    return sql;
+}
+
+QString select_spectr_sql(const bool &by_params)
+{
+    QString sql;
+
+    QStringList str_select;
+
+    str_select << "SELECT data_spectr FROM"
+               << spectr_data_table;
+
+    if(by_params)
+        str_select << "WHERE params_id = :params_id";
+
+    str_select << "ORDER BY id_pk;";
+
+    sql.append(str_select.join(" "));
+
+    return sql;
+}
+
+QString vacuum_into_sql(const QString &file_name)
+{
+    QString sql;
+
+    if(!file_name.isEmpty())
+    {
+        QString escaped_name(file_name);
+        escaped_name.replace("'", "''");
+
+        sql = QString("VACUUM INTO '%1'").arg(escaped_name);
+    }
+
+    return sql;
+}
+
+QByteArray float_array(const QVector<float> &values)
+{
+    return QByteArray(reinterpret_cast<const char*>(values.constData()),
+                      values.size()*static_cast<int>(sizeof(float)));
+}
+
 QString format_size(const qint64 &size)
 {
     QStringList units = {"Bytes", "KB", "MB", "GB", "TB", "PB"};
@@ -147,9 +321,19 @@ qint64 dir_size(const QString &dir_path)
     return size;
 }
 
-bool file_compress(const QString &in_file, const QString &out_file, int compressionLevel)
+static QByteArray compress_block(const QByteArray &block, int compressionLevel)
+{
+    return qCompress(block, compressionLevel);
+}
+
+bool file_compress(const QString &in_file, const QString &out_file, int compressionLevel,
+                   int thread_count, compress_stat *stat)
 {
     bool is_compressed(false);
+    compress_stat result;
+
+    QElapsedTimer timer;
+    timer.start();
 
     if((!in_file.isEmpty())&&(!out_file.isEmpty()))
     {
@@ -161,10 +345,61 @@ bool file_compress(const QString &in_file, const QString &out_file, int compress
 
         if(in_file_read.isOpen()&&out_file_write.isOpen())
         {
-            QByteArray uncompressed_data = in_file_read.readAll();
-            QByteArray compressed_data = qCompress(uncompressed_data, compressionLevel);
+            QDataStream out(&out_file_write);
+            out.writeRawData(backup_file_magic.constData(), backup_file_magic.size());
+            out << backup_file_version << static_cast<quint32>(backup_block_size);
+
+            // blocks are compressed independently, so up to "thread_count"
+            // blocks are in memory at the same time
+            const int batch_size = qMax(1, thread_count);
+            bool is_error(out.status() != QDataStream::Ok);
+
+            while((!is_error)&&(!in_file_read.atEnd()))
+            {
+                QVector<QByteArray> batch;
+
+                for(int i=0; (i<batch_size)&&(!in_file_read.atEnd()); ++i)
+                {
+                    const QByteArray block = in_file_read.read(backup_block_size);
+
+                    if(block.isEmpty())
+                        break;
+
+                    result.m_in_size += block.size();
+                    batch.append(block);
+                }
 
-            out_file_write.write(compressed_data);
+                if(batch.size() > 1)
+                {
+                    QVector<QFuture<QByteArray> > futures;
+
+                    for(int i=0; i<batch.size(); ++i)
+                        futures.append(QtConcurrent::run(compress_block, batch.at(i), compressionLevel));
+
+                    for(int i=0; i<futures.size(); ++i)
+                        batch[i] = futures[i].result();
+                }else{
+                    for(int i=0; i<batch.size(); ++i)
+                        batch[i] = compress_block(batch.at(i), compressionLevel);
+                }
+
+                for(int i=0; i<batch.size(); ++i)
+                {
+                    const QByteArray &compressed_data = batch.at(i);
+
+                    out << static_cast<quint32>(compressed_data.size());
+                    out.writeRawData(compressed_data.constData(), compressed_data.size());
+                }
+
+                is_error = (in_file_read.error() != QFileDevice::NoError)
+                        || (out.status() != QDataStream::Ok);
+            }
+
+            // end of stream
+            out << static_cast<quint32>(0);
+
+            is_compressed = (!is_error)&&(out.status() == QDataStream::Ok)&&out_file_write.flush();
+            result.m_out_size = out_file_write.size();
         }
 
         if(in_file_read.isOpen())
@@ -174,6 +409,12 @@ bool file_compress(const QString &in_file, const QString &out_file, int compress
             out_file_write.close();
     }
 
+    result.m_success = is_compressed;
+    result.m_elapsed = timer.elapsed();
+
+    if(stat)
+        *stat = result;
+
     return is_compressed;
 }
 
@@ -189,10 +430,56 @@ bool file_uncompressed(const QString &in_file, const QString &out_file)
 
     if(in_file_read.isOpen()&&out_file_write.isOpen())
     {
-        QByteArray compressed_data = in_file_read.readAll();
-        QByteArray uncompressed_data = qUncompress(compressed_data);
+        QDataStream in(&in_file_read);
 
-        out_file_write.write(uncompressed_data);
+        QByteArray magic(backup_file_magic.size(), Qt::Uninitialized);
+        quint32 version = 0;
+        quint32 block_size = 0;
+
+        in.readRawData(magic.data(), magic.size());
+        in >> version >> block_size;
+
+        // sizes of the header are checked before any allocation
+        if((magic == backup_file_magic)&&(version == backup_file_version)&&(block_size == backup_block_size))
+        {
+            // qCompress: 4 bytes of uncompressed size + zlib stream (deflate bound)
+            const quint32 compressed_size_max = static_cast<quint32>(backup_block_size + backup_block_size/1000 + 64 + 4);
+
+            quint32 compressed_size = 0;
+            in >> compressed_size;
+
+            while((in.status() == QDataStream::Ok)&&(compressed_size > 0))
+            {
+                if(compressed_size > compressed_size_max)
+                    break;
+
+                QByteArray compressed_data(static_cast<int>(compressed_size), Qt::Uninitialized);
+
+                if(in.readRawData(compressed_data.data(), compressed_data.size()) != compressed_data.size())
+                    break;
+
+                // uncompressed size of the block (big endian), at most block_size
+                if(compressed_size < 4)
+                    break;
+
+                const quint32 uncompressed_size = qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(compressed_data.constData()));
+
+                if(uncompressed_size > block_size)
+                    break;
+
+                const QByteArray uncompressed_data = qUncompress(compressed_data);
+
+                if(uncompressed_data.isEmpty())
+                    break;
+
+                out_file_write.write(uncompressed_data);
+
+                in >> compressed_size;
+            }
+
+            is_uncompressed = (in.status() == QDataStream::Ok)&&(compressed_size == 0)
+                    &&(out_file_write.error() == QFileDevice::NoError);
+        }
     }
 
     if(in_file_read.isOpen())
@@ -203,5 +490,3 @@ bool file_uncompressed(const QString &in_file, const QString &out_file)
 
     return is_uncompressed;
 }
-
-
@@ -3,23 +3,76 @@
 
 #include <QString>
 #include <QMap>
+#include <QVector>
 #include <QDir>
 #include <QDataStream>
 
+#include "sweep_write_settings.h"
+
 static const QString database_driver = "QSQLITE";
 
 static const QString connection_write = "data_write";
 static const QString connection_read = "data_read";
 static const QString connection_delete = "data_delete";
 static const QString connection_system = "ctrl_system";
+static const QString connection_backup = "data_backup";
+static const QString connection_rollup = "data_rollup";
+static const QString connection_occupancy = "data_occupancy";
+static const QString connection_export = "data_export";
 
 // spectr result table name
 static const QString spectr_data_table = "spectr_data_tbl";
 // spectr params table name
 static const QString spectr_params_table = "spectr_params_tbl";
+// rollup tables name (per minute, per hour)
+static const QString spectr_rollup_minute_table = "spectr_rollup_minute_tbl";
+static const QString spectr_rollup_hour_table = "spectr_rollup_hour_tbl";
+// occupancy statistics table name (per window)
+static const QString spectr_occupancy_table = "spectr_occupancy_tbl";
 
 // result database (data) (template)
 static const QString result_database_name = "db_chunk_%1.sqlite";
+// rollup database (not rotated)
+static const QString rollup_database_name = "db_rollup.sqlite";
+// statistics database (not rotated), written at ingest, read by db reader
+static const QString stat_database_name = "db_stat.sqlite";
+
+// result spectr log segment (template)
+static const QString result_log_name = "db_chunk_%1.sweeplog";
+
+// empty chunk (tables and pragmas), copied over a chunk on recycling
+static const QString template_database_name = "db_chunk_template.sqlite";
+static const QString template_log_name = "db_chunk_template.sweeplog";
+// consistent copy of the chunk taken before compression
+static const QString snapshot_database_suffix = ".snapshot";
+
+// messages written by the db writer per event loop iteration
+static const int ingest_batch_size = 64;
+
+// rollup/occupancy buckets and retention (ms)
+static const qint64 ms_in_second = 1000;
+static const qint64 ms_in_minute = 60*ms_in_second;
+static const qint64 ms_in_hour = 60*ms_in_minute;
+
+// percentile sketch: histogram per bin (dB)
+static const float occupancy_histogram_min = -150;
+static const float occupancy_histogram_step = 1;
+static const int occupancy_histogram_size = 180;
+
+// rows returned by db reader per request (default)
+static const int reader_row_limit = 1000;
+
+// export: matrix file and JSON sidecar, written in blocks of export_block_size
+static const QString export_data_suffix = ".bin";
+static const QString export_sidecar_suffix = ".json";
+static const quint32 export_file_version = 1;
+static const int export_block_size = 4*1024*1024;
+
+// backup file (block compressed stream)
+static const QByteArray backup_file_magic("QSWB");
+static const quint32 backup_file_version = 1;
+// uncompressed block size (bytes)
+static const qint64 backup_block_size = 1024*1024;
 
 // SQLITE data type
 static const QString sqlite_type_numeric(QString("NUMERIC"));
@@ -32,6 +85,22 @@ static const QString sqlite_type_datetime(QString("DATETIME"));
 static const QString sqlite_type_double(QString("DOUBLE PRECISION"));
 static const QString sqlite_type_blob(QString("BLOB"));
 
+// result of file compression
+struct compress_stat
+{
+    bool m_success = false;
+    qint64 m_in_size = 0;       // bytes read
+    qint64 m_out_size = 0;      // bytes written
+    qint64 m_elapsed = 0;       // ms
+
+    qreal ratio()const {
+        return m_out_size > 0 ? static_cast<qreal>(m_in_size)/m_out_size : 0;
+    }
+    qreal speed_mb()const {     // MB/s (uncompressed)
+        return m_elapsed > 0 ? (static_cast<qreal>(m_in_size)/1024/1024)/(static_cast<qreal>(m_elapsed)/1000) : 0;
+    }
+};
+
 static const QMap<QString, QString> column_spectr_params
 {
     {"id_pk", sqlite_type_integer_pk},
@@ -52,16 +121,89 @@ static const QMap<QString, QMap<QString, QString> > table
     {spectr_data_table, column_spectr_data}
 };
 
-QStringList list_of_all_chunk_files(const QString &db_path, const qint32 &db_file_count);
+// rollup: min/mean/max per bin (float32 arrays)
+static const QMap<QString, QString> column_spectr_rollup
+{
+    {"id_pk", sqlite_type_integer_pk},
+    {"params_id", sqlite_type_char.arg(8)},
+    {"dt_start", sqlite_type_integer},
+    {"hz_low", sqlite_type_integer},
+    {"hz_high", sqlite_type_integer},
+    {"fft_bin_width", sqlite_type_double},
+    {"sweep_count", sqlite_type_integer},
+    {"data_min", sqlite_type_blob},
+    {"data_mean", sqlite_type_blob},
+    {"data_max", sqlite_type_blob}
+};
+
+static const QMap<QString, QMap<QString, QString> > rollup_table
+{
+    {spectr_rollup_minute_table, column_spectr_rollup},
+    {spectr_rollup_hour_table, column_spectr_rollup}
+};
+
+// occupancy: fraction above threshold, mean, max, percentiles per bin (float32 arrays)
+static const QMap<QString, QString> column_spectr_occupancy
+{
+    {"id_pk", sqlite_type_integer_pk},
+    {"params_id", sqlite_type_char.arg(8)},
+    {"dt_start", sqlite_type_integer},
+    {"dt_window", sqlite_type_integer},
+    {"hz_low", sqlite_type_integer},
+    {"hz_high", sqlite_type_integer},
+    {"fft_bin_width", sqlite_type_double},
+    {"threshold", sqlite_type_double},
+    {"sweep_count", sqlite_type_integer},
+    {"data_occupancy", sqlite_type_blob},
+    {"data_mean", sqlite_type_blob},
+    {"data_max", sqlite_type_blob},
+    {"data_p50", sqlite_type_blob},
+    {"data_p90", sqlite_type_blob}
+};
+
+static const QMap<QString, QMap<QString, QString> > stat_table
+{
+    {spectr_occupancy_table, column_spectr_occupancy}
+};
+
+// SQL of a table, built once from the column maps above (first use)
+struct table_schema
+{
+    QString m_name;
+    QStringList m_columns;          // column order of CREATE TABLE
+    QStringList m_insert_columns;   // without INTEGER PRIMARY KEY (rowid alias)
+    QString m_create_sql;
+    QString m_insert_sql;           // positional ("?"), bound by index of m_insert_columns
+    QString m_insert_named_sql;     // ":column" placeholders
+
+    bool is_valid()const { return !m_columns.isEmpty(); }
+    int insert_index(const QString &column)const { return m_insert_columns.indexOf(column); }
+};
+
+const table_schema &schema_of(const QString &table_name);
+
+QString chunk_file_template(const storage_type &type);
+QString chunk_template_file(const storage_type &type);
+QStringList list_of_all_chunk_files(const QString &db_path, const qint32 &db_file_count,
+                                    const QString &file_template = result_database_name);
 QString pragma_sql(const QString &param, const QString &value);
+QMap<QString, QString> table_columns(const QString &table_name);
 QString list_column_and_type(const QString &table_name);
 QString list_column_prefix(const QString &table_name, const QString &prefix);
 QString create_table_sql(const QString &table_name);
 QString insert_table_sql(const QString &table_name);
 QString delete_table_sql(const QString &table_name);
+QString drop_table_sql(const QString &table_name);
+QString create_index_sql(const QString &table_name, const QString &column);
+QString delete_before_sql(const QString &table_name, const QString &column);
+QString select_range_sql(const QString &table_name, const QString &column, const bool &by_params);
+QString select_spectr_sql(const bool &by_params);
+QString vacuum_into_sql(const QString &file_name);
+QByteArray float_array(const QVector<float> &values);
 QString format_size(const qint64 &size);
 qint64 dir_size(const QString &dir_path);
-bool file_compress(const QString &in_file, const QString &out_file, int compressionLevel = -1);
+bool file_compress(const QString &in_file, const QString &out_file, int compressionLevel = -1,
+                   int thread_count = 1, compress_stat *stat = Q_NULLPTR);
 bool file_uncompressed(const QString &in_file, const QString &out_file);
 
 template<typename data_type>
@@ -1,7 +1,6 @@
 #include "db_custom_workers.h"
 
 #include <QSqlError>
-#include <QSqlRecord>
 
 #include "db_const.h"
 
@@ -62,6 +61,8 @@ bool db_custom_workers::is_open_db() const
 
 void db_custom_workers::close_db()
 {
+    m_schema_cache.clear();
+
     if(m_dbase.isOpen())
         m_dbase.close();
 }
@@ -97,26 +98,28 @@ void db_custom_workers::update_last_error(QSqlQuery *query)
 }
 
 bool db_custom_workers::is_table_name_resolve(const QString &table_name)
+{
+    if(m_dbase.isOpen()&&(!table_name.isEmpty()))
+        return m_schema_cache.contains(m_dbase, table_name);
+
+    return false;
+}
+
+bool db_custom_workers::create_table(const QString &table_name)
 {
     if(m_dbase.isOpen()&&(!table_name.isEmpty()))
     {
-        QSqlQuery* query = new QSqlQuery(m_dbase);
-        QString str_sql = QString("SELECT name FROM sqlite_master WHERE type =:table AND name = '%1' ").arg(table_name);
-        query->prepare(str_sql);
-        query->bindValue(":table", "table");
-        if(!query->exec())
-            update_last_error(query);
-        int field_no = query->record().indexOf("name");
-
-        while (query->next()) {
-            QString _name = query->value(field_no).toString();
-
-            // если таблица существует
-            if(_name.contains(table_name, Qt::CaseInsensitive))
-                return true;
+        QSqlQuery query(m_dbase);
+
+        if(query.exec(create_table_sql(table_name)))
+        {
+            m_schema_cache.insert(table_name);
+            return true;
         }
-        return false;
+
+        update_last_error(&query);
     }
+
     return false;
 }
 
@@ -137,10 +140,9 @@ void db_custom_workers::set_pragma(const QString &param, const QString &value)
 
     if (m_dbase.isOpen())
     {
-        QSqlQuery* query = new QSqlQuery(m_dbase);
-        query->prepare(sql_query);
+        QSqlQuery query(m_dbase);
 
-        if(!query->exec())
-            update_last_error(query);
+        if(!query.exec(sql_query))
+            update_last_error(&query);
     }
 }
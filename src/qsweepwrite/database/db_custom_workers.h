@@ -8,6 +8,7 @@
 
 #include "sweep_write_settings.h"
 #include "db_state_workers.h"
+#include "db_statement.h"
 
 class db_custom_workers : public QObject
 {
@@ -30,6 +31,7 @@ public slots:
 
 protected:
     QSqlDatabase m_dbase;
+    schema_cache m_schema_cache;
     QString m_str_error_dbase;
     sweep_write_settings m_settings;
 
@@ -42,6 +44,7 @@ protected:
 
     void update_last_error(QSqlQuery* query);    
     bool is_table_name_resolve(const QString &);
+    bool create_table(const QString &);
     void update_size_file(const QString &);
 
     void set_pragma(const QString &, const QString &);
@@ -0,0 +1,452 @@
+#include "db_export_worker.h"
+#include "db_const.h"
+#include "spectr_log_reader.h"
+
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "sweep_message.h"
+#include "reader_ctrl.h"
+#include "data_spectr.h"
+#include "data_log.h"
+#include "constkeys.h"
+
+#ifdef QT_DEBUG
+#include <QtCore/qdebug.h>
+#endif
+
+db_export_worker::db_export_worker(QObject *parent) : db_custom_workers(parent)
+{
+    setObjectName(this->metaObject()->className());
+
+    m_dbase = QSqlDatabase::addDatabase(database_driver, connection_export);
+}
+
+void db_export_worker::slot_initialization()
+{
+    const QString path = m_settings.export_path().isEmpty()
+            ? m_settings.db_path() : m_settings.export_path();
+
+    if((!path.isEmpty())&&(!QDir(path).exists()))
+        QDir().mkpath(path);
+
+    emit signal_update_state_workers(state_workers::initialization);
+}
+
+void db_export_worker::slot_reader_ctrl(const QByteArray &json)
+{
+    const reader_ctrl ctrl(json);
+
+    if(!ctrl.is_valid())
+        return;
+
+    if(ctrl.ctrl_type() == reader_ctrl_type::export_spectr)
+        export_spectr(ctrl);
+}
+
+void db_export_worker::export_spectr(const reader_ctrl &ctrl)
+{
+    // only the base name is used, files are created in export_path
+    QString base_name = QFileInfo(ctrl.file_name()).fileName();
+
+    if(base_name.isEmpty())
+        base_name = QString("export_%1").arg(QDateTime::currentDateTimeUtc().toString("yyyyMMdd_hhmmss"));
+
+    const QString path = m_settings.export_path().isEmpty()
+            ? m_settings.db_path() : m_settings.export_path();
+    const QString file_prefix = path.isEmpty() ? base_name : path + QDir::separator() + base_name;
+    const QString data_file_name = file_prefix + export_data_suffix;
+
+    m_params_id = ctrl.id_params();
+    m_from = ctrl.dt_from().isValid() ? ctrl.dt_from().toMSecsSinceEpoch() : std::numeric_limits<qint64>::min();
+    m_to = ctrl.dt_to().isValid() ? ctrl.dt_to().toMSecsSinceEpoch() : std::numeric_limits<qint64>::max();
+    m_hz_low = ctrl.hz_low();
+    m_hz_high = ctrl.hz_high() > 0 ? ctrl.hz_high() : std::numeric_limits<quint64>::max();
+    m_row_limit = ctrl.limit();
+    m_layout_hz_low.clear();
+    m_layout_size.clear();
+    m_first_column = 0;
+    m_frequency.clear();
+    m_time.clear();
+    m_skipped = 0;
+    m_write_error = false;
+    m_block.clear();
+    m_block.reserve(export_block_size);
+
+    m_file.setFileName(data_file_name);
+
+    // large sequential writes, no second buffer in QFile
+    if(!m_file.open(QIODevice::WriteOnly|QIODevice::Truncate|QIODevice::Unbuffered))
+    {
+        publish_log(tr("export: can't open file %1").arg(data_file_name));
+        return;
+    }
+
+    const QStringList list_chunk = chunk_files();
+
+    for(int i=0; (i<list_chunk.size())&&(!is_stopped()); ++i)
+    {
+        if(m_settings.storage() == storage_type::spectr_log)
+            export_log_chunk(list_chunk.at(i));
+        else
+            export_sqlite_chunk(list_chunk.at(i));
+    }
+
+    bool is_ok = write_block()&&(!m_write_error);
+
+    // time and frequency axis after the matrix (8 byte aligned)
+    const qint64 power_size = m_file.size();
+    const qint64 padding = (8 - power_size%8)%8;
+
+    if(is_ok&&(padding > 0))
+        is_ok = m_file.write(QByteArray(static_cast<int>(padding), '\0')) == padding;
+
+    if(is_ok)
+    {
+        const qint64 time_size = m_time.size()*static_cast<qint64>(sizeof(qint64));
+        const qint64 frequency_size = m_frequency.size()*static_cast<qint64>(sizeof(double));
+
+        is_ok = (m_file.write(reinterpret_cast<const char*>(m_time.constData()), time_size) == time_size)
+                &&(m_file.write(reinterpret_cast<const char*>(m_frequency.constData()), frequency_size) == frequency_size);
+    }
+
+    m_file.close();
+
+    if(is_ok)
+        is_ok = write_sidecar(file_prefix + export_sidecar_suffix, QFileInfo(data_file_name).fileName());
+
+    if(is_ok)
+        publish_log(tr("export: %1 rows: %2 columns: %3 skipped: %4")
+                    .arg(data_file_name).arg(m_time.size()).arg(m_frequency.size()).arg(m_skipped));
+    else
+        publish_log(tr("export: write error %1").arg(data_file_name));
+
+    m_block.clear();
+    m_block.squeeze();
+}
+
+void db_export_worker::export_sqlite_chunk(const QString &file_name)
+{
+    open_db(file_name);
+
+    if(!is_open_db())
+        return;
+
+    // the chunk can be written by db writer at the same time
+    set_pragma("busy_timeout", "1000");
+    set_pragma("query_only", "1");
+
+    {
+        const bool by_params = !m_params_id.isEmpty();
+
+        QSqlQuery query(m_dbase);
+        query.setForwardOnly(true);
+        query.prepare(select_spectr_sql(by_params));
+
+        if(by_params)
+            query.bindValue(":params_id", m_params_id);
+
+        if(query.exec())
+        {
+            while(query.next()&&(!is_stopped()))
+            {
+                const data_spectr spectr(query.value(0).toByteArray());
+                const QVector<power_spectr> powers(spectr.spectr());
+
+                if(powers.isEmpty())
+                    continue;
+
+                const qint64 time = powers.first().m_date_time.isValid()
+                        ? powers.first().m_date_time.toMSecsSinceEpoch() : 0;
+
+                if((time < m_from)||(time >= m_to))
+                    continue;
+
+                QVector<export_segment> segments(powers.size());
+
+                for(int i=0; i<powers.size(); ++i)
+                {
+                    segments[i].m_hz_low = powers.at(i).hz_low;
+                    segments[i].m_hz_high = powers.at(i).hz_high;
+                    segments[i].m_power.resize(powers.at(i).m_power.size());
+
+                    for(int w=0; w<powers.at(i).m_power.size(); ++w)
+                        segments[i].m_power[w] = static_cast<float>(powers.at(i).m_power.at(w));
+                }
+
+                append_sweep(time, segments);
+            }
+        }else{
+            update_last_error(&query);
+        }
+    }
+
+    close_db();
+}
+
+void db_export_worker::export_log_chunk(const QString &file_name)
+{
+    spectr_log_reader reader;
+
+    // segment of db writer is readable after it is closed
+    if(!reader.open(file_name))
+        return;
+
+    const QByteArray params_id = m_params_id.toLatin1();
+    qint64 offset = m_from > 0 ? reader.seek(m_from) : reader.begin();
+
+    // records of one sweep are consecutive, a repeated hz_low starts the next sweep
+    QVector<export_segment> segments;
+    qint64 sweep_time = 0;
+    log_record_view record;
+
+    while(reader.next(offset, record)&&(!is_stopped()))
+    {
+        const log_record_header &header = record.m_header;
+
+        if(header.m_type != log_record_spectr)
+            continue;
+
+        if((!params_id.isEmpty())
+                &&(std::strncmp(header.m_params_id, params_id.constData(), sizeof(header.m_params_id)) != 0))
+            continue;
+
+        if(header.m_time >= m_to)
+            break;
+
+        if(header.m_time < m_from)
+            continue;
+
+        const bool is_next_sweep = std::any_of(segments.constBegin(), segments.constEnd(),
+                                               [&header](const export_segment &segment) {
+            return segment.m_hz_low == header.m_hz_low;
+        });
+
+        if(is_next_sweep)
+        {
+            append_sweep(sweep_time, segments);
+            segments.clear();
+        }
+
+        if(segments.isEmpty())
+            sweep_time = header.m_time;
+
+        export_segment segment;
+        segment.m_hz_low = header.m_hz_low;
+        segment.m_hz_high = header.m_hz_high;
+        segment.m_power.resize(static_cast<int>(header.m_bin_count));
+        std::memcpy(segment.m_power.data(), record.m_power, header.m_bin_count*sizeof(float));
+
+        segments.append(segment);
+    }
+
+    if((!segments.isEmpty())&&(!is_stopped()))
+        append_sweep(sweep_time, segments);
+
+    reader.close();
+}
+
+QStringList db_export_worker::chunk_files() const
+{
+    QFileInfoList list_info;
+    const QStringList list_chunk = list_of_all_chunk_files(m_settings.db_path(), m_settings.db_file_count(),
+                                                           chunk_file_template(m_settings.storage()));
+
+    for(const auto &file_name : list_chunk)
+    {
+        QFileInfo info(file_name);
+
+        if(info.exists())
+            list_info.append(info);
+    }
+
+    // chunks are recycled in turn: oldest data first
+    std::sort(list_info.begin(), list_info.end(), [](const QFileInfo &a, const QFileInfo &b) {
+        return a.lastModified() < b.lastModified();
+    });
+
+    QStringList list_sorted;
+
+    for(const auto &info : list_info)
+        list_sorted.append(info.absoluteFilePath());
+
+    return list_sorted;
+}
+
+bool db_export_worker::is_full() const
+{
+    return (m_row_limit > 0)&&(m_time.size() >= m_row_limit);
+}
+
+bool db_export_worker::is_stopped() const
+{
+    return m_write_error||is_full();
+}
+
+bool db_export_worker::set_layout(const QVector<export_segment> &segments)
+{
+    QVector<double> frequency;
+
+    for(const auto &segment : segments)
+    {
+        const int size = segment.m_power.size();
+
+        m_layout_hz_low.append(segment.m_hz_low);
+        m_layout_size.append(size);
+
+        if(size == 0)
+            continue;
+
+        const double bin_width = static_cast<double>(segment.m_hz_high - segment.m_hz_low)/size;
+
+        for(int i=0; i<size; ++i)
+            frequency.append(segment.m_hz_low + (i + 0.5)*bin_width);
+    }
+
+    // columns of the frequency window (bins are in increasing order)
+    const auto first = std::lower_bound(frequency.constBegin(), frequency.constEnd(), static_cast<double>(m_hz_low));
+    const auto last = std::upper_bound(first, frequency.constEnd(), static_cast<double>(m_hz_high));
+
+    m_first_column = static_cast<int>(first - frequency.constBegin());
+    m_frequency = frequency.mid(m_first_column, static_cast<int>(last - first));
+
+    return !m_frequency.isEmpty();
+}
+
+void db_export_worker::append_sweep(const qint64 &time, QVector<export_segment> &segments)
+{
+    std::sort(segments.begin(), segments.end(), [](const export_segment &a, const export_segment &b) {
+        return a.m_hz_low < b.m_hz_low;
+    });
+
+    if(m_layout_hz_low.isEmpty())
+    {
+        if(!set_layout(segments))
+        {
+            m_layout_hz_low.clear();
+            m_layout_size.clear();
+            m_skipped++;
+            return;
+        }
+    }
+
+    bool is_same_layout(segments.size() == m_layout_hz_low.size());
+
+    for(int i=0; (i<segments.size())&&is_same_layout; ++i)
+        is_same_layout = (segments.at(i).m_hz_low == m_layout_hz_low.at(i))
+                &&(segments.at(i).m_power.size() == m_layout_size.at(i));
+
+    if(!is_same_layout)
+    {
+        m_skipped++;
+        return;
+    }
+
+    // columns [m_first_column, m_first_column + m_frequency.size())
+    const int row_end = m_first_column + m_frequency.size();
+    int column = 0;
+
+    for(const auto &segment : segments)
+    {
+        const int size = segment.m_power.size();
+        const int from = qMax(column, m_first_column);
+        const int to = qMin(column + size, row_end);
+
+        if(from < to)
+            m_block.append(reinterpret_cast<const char*>(segment.m_power.constData() + (from - column)),
+                           (to - from)*static_cast<int>(sizeof(float)));
+
+        column += size;
+    }
+
+    m_time.append(time);
+
+    if(m_block.size() >= export_block_size)
+        write_block();
+}
+
+bool db_export_worker::write_block()
+{
+    if(m_block.isEmpty())
+        return true;
+
+    const bool is_ok = m_file.write(m_block) == m_block.size();
+
+    if(!is_ok)
+        m_write_error = true;
+
+    m_block.resize(0);
+
+    return is_ok;
+}
+
+bool db_export_worker::write_sidecar(const QString &file_name, const QString &data_file_name)
+{
+    const qint64 rows = m_time.size();
+    const qint64 columns = m_frequency.size();
+    const qint64 power_size = rows*columns*static_cast<qint64>(sizeof(float));
+    const qint64 time_offset = power_size + (8 - power_size%8)%8;
+    const qint64 frequency_offset = time_offset + rows*static_cast<qint64>(sizeof(qint64));
+
+    QJsonObject power;
+    power.insert("dtype", "float32");
+    power.insert("offset", 0);
+    power.insert("shape", QJsonArray({rows, columns}));
+    power.insert("unit", "dB");
+
+    QJsonObject time;
+    time.insert("dtype", "int64");
+    time.insert("offset", time_offset);
+    time.insert("shape", QJsonArray({rows}));
+    time.insert("unit", "ms since epoch (UTC)");
+
+    QJsonObject frequency;
+    frequency.insert("dtype", "float64");
+    frequency.insert("offset", frequency_offset);
+    frequency.insert("shape", QJsonArray({columns}));
+    frequency.insert("unit", "Hz (bin centre)");
+
+    QJsonObject json_object;
+    json_object.insert("format", "qsweep_export");
+    json_object.insert("version", static_cast<qint64>(export_file_version));
+    json_object.insert("data_file", data_file_name);
+    json_object.insert("byte_order", Q_BYTE_ORDER == Q_LITTLE_ENDIAN ? "little" : "big");
+    json_object.insert(ID_PARAMS_KEY, m_params_id);
+    json_object.insert("skipped_sweeps", m_skipped);
+    json_object.insert("power", power);
+    json_object.insert("time", time);
+    json_object.insert("frequency", frequency);
+
+    QFile file(file_name);
+
+    if(!file.open(QIODevice::WriteOnly|QIODevice::Truncate|QIODevice::Text))
+        return false;
+
+    const QByteArray json = QJsonDocument(json_object).toJson(QJsonDocument::Indented);
+    const bool is_ok = file.write(json) == json.size();
+
+    file.close();
+
+    return is_ok;
+}
+
+void db_export_worker::publish_log(const QString &text)
+{
+#ifdef QT_DEBUG
+    qInfo() << text;
+#endif
+
+    data_log log;
+    log.set_text_message(text);
+
+    sweep_message send_data;
+    send_data.set_type(type_message::data_message_log);
+    send_data.set_data_message(log.to_json());
+
+    emit signal_publish_message(send_data.to_json());
+}
@@ -0,0 +1,78 @@
+#ifndef DB_EXPORT_WORKER_H
+#define DB_EXPORT_WORKER_H
+
+#include <QFile>
+#include <QVector>
+
+#include "db_custom_workers.h"
+
+class reader_ctrl;
+
+// one segment of an exported sweep
+struct export_segment
+{
+    quint64 m_hz_low = 0;
+    quint64 m_hz_high = 0;
+    QVector<float> m_power;
+};
+
+// Export of recorded sweeps (reader_ctrl_type::export_spectr) from the
+// chunks to "<file_name>.bin" and a JSON sidecar "<file_name>.json":
+//   float32 powers [rows][columns] (offset 0, row major, host byte order)
+//   int64 time [rows] (ms since epoch, UTC)
+//   float64 frequency [columns] (Hz, bin centre)
+// offsets and shapes are in the sidecar, the file can be memory mapped
+// (numpy.memmap). The layout of the first exported sweep is used, sweeps
+// with another layout are skipped
+class db_export_worker : public db_custom_workers
+{
+    Q_OBJECT
+public:
+    explicit db_export_worker(QObject *parent = nullptr);
+
+public slots:
+    void slot_initialization() Q_DECL_OVERRIDE;
+
+    // request (reader_ctrl json)
+    void slot_reader_ctrl(const QByteArray &);
+
+signals:
+    // result (sweep_message json, data_message_log)
+    void signal_publish_message(const QByteArray &);
+
+private:
+    QFile m_file;
+    QByteArray m_block;
+    QString m_params_id;
+    qint64 m_from {0};
+    qint64 m_to {0};
+    quint64 m_hz_low {0};
+    quint64 m_hz_high {0};
+    qint64 m_row_limit {0};
+
+    // layout of the first sweep: hz_low and bin count of every segment
+    QVector<quint64> m_layout_hz_low;
+    QVector<int> m_layout_size;
+    int m_first_column {0};
+    QVector<double> m_frequency;
+    QVector<qint64> m_time;
+    qint64 m_skipped {0};
+    // sticky: set by a failed block write, stops the export
+    bool m_write_error {false};
+
+    void export_spectr(const reader_ctrl &);
+    void export_sqlite_chunk(const QString &);
+    void export_log_chunk(const QString &);
+    QStringList chunk_files()const;
+
+    bool is_full()const;
+    bool is_stopped()const;
+    bool set_layout(const QVector<export_segment> &);
+    void append_sweep(const qint64 &time, QVector<export_segment> &);
+    bool write_block();
+    bool write_sidecar(const QString &file_name, const QString &data_file_name);
+
+    void publish_log(const QString &);
+};
+
+#endif // DB_EXPORT_WORKER_H
@@ -5,6 +5,12 @@
 #include <QStorageInfo>
 
 #include "sweep_message.h"
+#include "constkeys.h"
+#include "db_const.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 
 #ifdef QT_DEBUG
 #include <QtCore/qdebug.h>
@@ -16,6 +22,7 @@ db_manager::db_manager(QObject *parent) : QObject(parent)
 
     qRegisterMetaType<state_workers>();
     qRegisterMetaType<state_db>();
+    qRegisterMetaType<data_spectr>();
 
     ptr_db_state_workers = new db_state_workers(this);
 
@@ -29,12 +36,33 @@ db_manager::db_manager(QObject *parent) : QObject(parent)
     connect(ptr_db_state_workers, &db_state_workers::signal_all_stopping,
             this, &db_manager::slot_is_all_stopping_workers);
 
+    // ingest queue metrics
+    auto timer_ingest_stat = new QTimer(this);
+    connect(timer_ingest_stat, &QTimer::timeout,
+            this, &db_manager::slot_ingest_stat);
+    timer_ingest_stat->start(5000);
+
 //    auto timer = new QTimer();
 //    connect(timer, SIGNAL(timeout()),
 //            this, SLOT(slot_test_received_data()));
 //    timer->start(500);
 }
 
+db_manager::~db_manager()
+{
+    // writers use ingest queues until their threads are finished
+    for(int i=0; i<m_db_writer_threads.size(); ++i)
+    {
+        if(m_db_writer_threads.at(i))
+        {
+            m_db_writer_threads.at(i)->quit();
+            m_db_writer_threads.at(i)->wait();
+        }
+    }
+
+    qDeleteAll(m_ingest_queues);
+}
+
 void db_manager::set_configuration(const sweep_write_settings &settings)
 {
     m_settings = settings;
@@ -47,22 +75,20 @@ void db_manager::initialization()
     if (!dir.exists())
         dir.mkpath(".");
 
-    if (dir.exists())
-    {
-        // remove all files
-        dir.setNameFilters(QStringList() << "*.*");
-        dir.setFilter(QDir::Files);
+    // existing chunks are kept (recovery in db writers)
+    qint64 chunk_size = 0;
+    const QStringList list_file(list_of_all_chunk_files(m_settings.db_path(), m_settings.db_file_count(),
+                                                        chunk_file_template(m_settings.storage())));
 
-        for(const QString &dirFile: dir.entryList())
-            dir.remove(dirFile);
-    }
+    for(int i=0; i<list_file.size(); ++i)
+        chunk_size += QFileInfo(list_file.at(i)).size();
 
     QStorageInfo storage(m_settings.db_path());
 
     if (storage.isValid() && storage.isReady())
     {
         // calc need free disk space (Mb)
-        qint64 need_size = m_settings.db_file_size()*m_settings.db_file_count();
+        qint64 need_size = m_settings.db_file_size()*m_settings.db_file_count() - chunk_size/1024/1024;
         qint64 available_size = storage.bytesAvailable()/1024/1024;
 
 #ifdef QT_DEBUG
@@ -74,14 +100,35 @@ void db_manager::initialization()
 #endif
         if(available_size > need_size)
         {
-            // db writer
-            create_db_writer_worker(ptr_db_state_workers);
+            // db writers (each writer owns at least one chunk)
+            const int writer_count = qBound(1, m_settings.db_writer_count(), qMax(1, m_settings.db_file_count()));
+
+            // db rollup (before writers: sweeps are connected to it)
+            if(m_settings.rollup())
+                create_db_rollup_worker(ptr_db_state_workers);
+
+            if(m_settings.occupancy())
+            {
+                create_db_occupancy_worker(ptr_db_state_workers);
+                create_db_reader_worker(ptr_db_state_workers);
+            }
+
+            if(m_settings.data_export())
+                create_db_export_worker(ptr_db_state_workers);
+
+            if(m_settings.event_detection())
+                create_event_detector_worker(ptr_db_state_workers);
+
+            for(int i=0; i<writer_count; ++i)
+                create_db_writer_worker(ptr_db_state_workers, i, writer_count);
             // db cleaner
             create_db_cleaner_worker(ptr_db_state_workers);
 
             if(m_settings.data_backup())
                 create_file_backup_worker(ptr_db_state_workers);
 
+            ptr_db_state_workers->set_data_backup(m_settings.data_backup());
+
             emit signal_initialization_workers();
 
         }else{
@@ -101,13 +148,22 @@ void db_manager::launching()
 
 void db_manager::stopping()
 {
+    is_ready = false;
 
+    // open tracks publish their stop events before return
+    if(ptr_event_detector_thread&&ptr_event_detector_thread->isRunning())
+        QMetaObject::invokeMethod(ptr_event_detector_worker, "slot_stopping", Qt::BlockingQueuedConnection);
+
+    emit signal_stopping_workers();
 }
 
 void db_manager::slot_is_all_initialization_workers()
 {
     is_ready = false;
 
+    for(auto queue : m_ingest_queues)
+        queue->set_consumer_running(false);
+
 #ifdef QT_DEBUG
     qDebug() << tr("all initialization workers");
 #endif
@@ -119,15 +175,24 @@ void db_manager::slot_is_all_launching_workers()
 {
     is_ready = true;
 
+    for(auto queue : m_ingest_queues)
+        queue->set_consumer_running(true);
+
 #ifdef QT_DEBUG
     qDebug() << tr("all launching workers");
 #endif
+
+    // data received before launching
+    emit signal_process_queue();
 }
 
 void db_manager::slot_is_all_stopping_workers()
 {
     is_ready = false;
 
+    for(auto queue : m_ingest_queues)
+        queue->set_consumer_running(false);
+
 #ifdef QT_DEBUG
     qDebug().noquote() << tr("all stopping workers");
 #endif
@@ -135,8 +200,74 @@ void db_manager::slot_is_all_stopping_workers()
 
 void db_manager::slot_received_data(const QByteArray &rc_data)
 {
-    if(is_ready)
-        emit signal_send_data_to_write(rc_data);
+    if(m_ingest_queues.isEmpty())
+        return;
+
+    const int index = writer_index(rc_data);
+
+    // data is queued before launching too,
+    // the writer is notified after "all launching workers"
+    if(m_ingest_queues.at(index)->push(rc_data)&&is_ready)
+        QMetaObject::invokeMethod(m_db_writer_workers.at(index), "slot_process_queue", Qt::QueuedConnection);
+}
+
+// route of a message without "route_id" (older publishers): full parse
+static void parse_route(const QByteArray &rc_data, QString &id, quint64 &hz_low)
+{
+    const sweep_message data_received(rc_data);
+    const QJsonObject json_object(QJsonDocument::fromJson(data_received.data_message()).object());
+
+    // params_spectr: id, frequency_min (MHz)
+    if(data_received.type() == type_message::ctrl_spectr)
+    {
+        id = json_object.value(ID_KEY).toString();
+        hz_low = json_object.value(FREQUENCY_MIN_KEY).toString().toULongLong()*1000000;
+        return;
+    }
+
+    const QJsonArray powers(json_object.value(POWERS_KEY).toArray());
+
+    id = json_object.value(ID_PARAMS_KEY).toString();
+    hz_low = powers.isEmpty() ? 0 : powers.first().toObject().value(FREQUENCY_MIN_KEY).toString().toULongLong();
+}
+
+int db_manager::writer_index(const QByteArray &rc_data) const
+{
+    const int count = m_ingest_queues.size();
+
+    if(count < 2)
+        return 0;
+
+    QString route_id;
+    quint64 route_hz = 0;
+
+    // publishers put the route next to "data": no parse on this (mqtt) thread
+    if(!sweep_message::peek_route(rc_data, route_id, route_hz))
+        parse_route(rc_data, route_id, route_hz);
+
+    // sweeps of one band (first segment) and their params go to one writer
+    if((m_settings.db_writer_sharding() == shard_policy::band)&&(m_settings.db_shard_band() > 0)&&(route_hz > 0))
+    {
+        const quint64 band = route_hz/(static_cast<quint64>(m_settings.db_shard_band())*1000000);
+
+        return static_cast<int>(band%static_cast<quint64>(count));
+    }
+
+    // params_spectr and data_spectr of one params_id go to one writer
+    return static_cast<int>(qHash(route_id)%static_cast<uint>(count));
+}
+
+void db_manager::slot_ingest_stat()
+{
+    for(int i=0; i<m_ingest_queues.size(); ++i)
+        ptr_db_state_workers->slot_ingest_stat(m_db_writer_workers.at(i)->objectName(),
+                                               m_ingest_queues.at(i)->stat());
+}
+
+void db_manager::slot_reader_ctrl(const QByteArray &json)
+{
+    if(ptr_db_reader_worker||ptr_db_export_worker)
+        emit signal_reader_ctrl(json);
 }
 
 void db_manager::slot_test_received_data()
@@ -170,15 +301,23 @@ void db_manager::slot_test_received_data()
     slot_received_data(send_data.to_json());
 }
 
-void db_manager::create_db_writer_worker(db_state_workers *state)
+void db_manager::create_db_writer_worker(db_state_workers *state, const int &index, const int &count)
 {
-    ptr_db_writer_worker = new db_writer_worker;
+    auto ptr_ingest_queue = new ingest_queue;
+    ptr_ingest_queue->set_configuration(m_settings, index);
+    m_ingest_queues.append(ptr_ingest_queue);
+
+    auto ptr_db_writer_worker = new db_writer_worker;
+    ptr_db_writer_worker->set_writer_index(index, count);
     ptr_db_writer_worker->set_configuration(m_settings);
+    ptr_db_writer_worker->set_ingest_queue(ptr_ingest_queue);
+    m_db_writer_workers.append(ptr_db_writer_worker);
 
     // add "db_writer_worker" to state monitor
-    state->add_name_workers(ptr_db_writer_worker->metaObject()->className());
+    state->add_name_workers(ptr_db_writer_worker->objectName());
 
-    ptr_db_writer_thread = new QThread;
+    QPointer<QThread> ptr_db_writer_thread = new QThread;
+    m_db_writer_threads.append(ptr_db_writer_thread);
     ptr_db_writer_worker->moveToThread(ptr_db_writer_thread);
 
     // initialization
@@ -199,13 +338,31 @@ void db_manager::create_db_writer_worker(db_state_workers *state)
     // monitor state db (file)
     connect(ptr_db_writer_worker, &db_writer_worker::signal_state_db,
             state, &db_state_workers::slot_state_db);
+    // active chunk
+    connect(ptr_db_writer_worker, &db_writer_worker::signal_active_chunk,
+            state, &db_state_workers::slot_active_chunk);
     // state file is ready
     connect(state, &db_state_workers::signal_file_is_ready,
             ptr_db_writer_worker, &db_writer_worker::slot_file_is_ready);
 
-    // send data to write db
-    connect(this, &db_manager::signal_send_data_to_write,
-            ptr_db_writer_worker, &db_writer_worker::slot_data_to_write);
+    // parsed sweeps to rollup
+    if(ptr_db_rollup_workers)
+        connect(ptr_db_writer_worker, &db_writer_worker::signal_data_spectr,
+                ptr_db_rollup_workers, &db_rollup_workers::slot_data_spectr);
+
+    // parsed sweeps to occupancy statistics
+    if(ptr_db_occupancy_workers)
+        connect(ptr_db_writer_worker, &db_writer_worker::signal_data_spectr,
+                ptr_db_occupancy_workers, &db_occupancy_workers::slot_data_spectr);
+
+    // parsed sweeps to event detection
+    if(ptr_event_detector_worker)
+        connect(ptr_db_writer_worker, &db_writer_worker::signal_data_spectr,
+                ptr_event_detector_worker, &event_detector_worker::slot_data_spectr);
+
+    // read ingest queue and write db
+    connect(this, &db_manager::signal_process_queue,
+            ptr_db_writer_worker, &db_writer_worker::slot_process_queue);
 
     ptr_db_writer_thread->start();
 }
@@ -237,6 +394,9 @@ void db_manager::create_db_cleaner_worker(db_state_workers *state)
     //
     connect(ptr_db_cleaner_workers, &db_cleaner_workers::signal_state_db,
             state, &db_state_workers::slot_state_db);
+    // recycle time
+    connect(ptr_db_cleaner_workers, &db_cleaner_workers::signal_recycle_time,
+            state, &db_state_workers::slot_recycle_time);
 
     ptr_db_cleaner_thread = new QThread;
     ptr_db_cleaner_workers->moveToThread(ptr_db_cleaner_thread);
@@ -244,6 +404,156 @@ void db_manager::create_db_cleaner_worker(db_state_workers *state)
     ptr_db_cleaner_thread->start();
 }
 
+void db_manager::create_db_rollup_worker(db_state_workers *state)
+{
+    ptr_db_rollup_workers = new db_rollup_workers;
+    ptr_db_rollup_workers->set_configuration(m_settings);
+
+    // add "db_rollup_workers" to state monitor
+    state->add_name_workers(ptr_db_rollup_workers->metaObject()->className());
+
+    // initialization
+    connect(this, &db_manager::signal_initialization_workers,
+            ptr_db_rollup_workers, &db_rollup_workers::slot_initialization);
+    // launching
+    connect(this, &db_manager::signal_launching_workers,
+            ptr_db_rollup_workers, &db_rollup_workers::slot_launching);
+    // stopping
+    connect(this, &db_manager::signal_stopping_workers,
+            ptr_db_rollup_workers, &db_rollup_workers::slot_stopping);
+
+    // state workers
+    connect(ptr_db_rollup_workers, &db_rollup_workers::signal_update_state_workers,
+            state, &db_state_workers::slot_update_state_workers);
+
+    ptr_db_rollup_thread = new QThread;
+    ptr_db_rollup_workers->moveToThread(ptr_db_rollup_thread);
+
+    ptr_db_rollup_thread->start();
+}
+
+void db_manager::create_db_occupancy_worker(db_state_workers *state)
+{
+    ptr_db_occupancy_workers = new db_occupancy_workers;
+    ptr_db_occupancy_workers->set_configuration(m_settings);
+
+    // add "db_occupancy_workers" to state monitor
+    state->add_name_workers(ptr_db_occupancy_workers->metaObject()->className());
+
+    // initialization
+    connect(this, &db_manager::signal_initialization_workers,
+            ptr_db_occupancy_workers, &db_occupancy_workers::slot_initialization);
+    // launching
+    connect(this, &db_manager::signal_launching_workers,
+            ptr_db_occupancy_workers, &db_occupancy_workers::slot_launching);
+    // stopping
+    connect(this, &db_manager::signal_stopping_workers,
+            ptr_db_occupancy_workers, &db_occupancy_workers::slot_stopping);
+
+    // state workers
+    connect(ptr_db_occupancy_workers, &db_occupancy_workers::signal_update_state_workers,
+            state, &db_state_workers::slot_update_state_workers);
+
+    ptr_db_occupancy_thread = new QThread;
+    ptr_db_occupancy_workers->moveToThread(ptr_db_occupancy_thread);
+
+    ptr_db_occupancy_thread->start();
+}
+
+void db_manager::create_db_reader_worker(db_state_workers *state)
+{
+    ptr_db_reader_worker = new db_reader_worker;
+    ptr_db_reader_worker->set_configuration(m_settings);
+
+    // add "db_reader_worker" to state monitor
+    state->add_name_workers(ptr_db_reader_worker->metaObject()->className());
+
+    // initialization
+    connect(this, &db_manager::signal_initialization_workers,
+            ptr_db_reader_worker, &db_reader_worker::slot_initialization);
+    // launching
+    connect(this, &db_manager::signal_launching_workers,
+            ptr_db_reader_worker, &db_reader_worker::slot_launching);
+    // stopping
+    connect(this, &db_manager::signal_stopping_workers,
+            ptr_db_reader_worker, &db_reader_worker::slot_stopping);
+
+    // state workers
+    connect(ptr_db_reader_worker, &db_reader_worker::signal_update_state_workers,
+            state, &db_state_workers::slot_update_state_workers);
+    // request and result (mqtt)
+    connect(this, &db_manager::signal_reader_ctrl,
+            ptr_db_reader_worker, &db_reader_worker::slot_reader_ctrl);
+    connect(ptr_db_reader_worker, &db_reader_worker::signal_publish_message,
+            this, &db_manager::signal_publish_message);
+
+    ptr_db_reader_thread = new QThread;
+    ptr_db_reader_worker->moveToThread(ptr_db_reader_thread);
+
+    ptr_db_reader_thread->start();
+}
+
+void db_manager::create_db_export_worker(db_state_workers *state)
+{
+    ptr_db_export_worker = new db_export_worker;
+    ptr_db_export_worker->set_configuration(m_settings);
+
+    // add "db_export_worker" to state monitor
+    state->add_name_workers(ptr_db_export_worker->metaObject()->className());
+
+    // initialization
+    connect(this, &db_manager::signal_initialization_workers,
+            ptr_db_export_worker, &db_export_worker::slot_initialization);
+    // launching
+    connect(this, &db_manager::signal_launching_workers,
+            ptr_db_export_worker, &db_export_worker::slot_launching);
+    // stopping
+    connect(this, &db_manager::signal_stopping_workers,
+            ptr_db_export_worker, &db_export_worker::slot_stopping);
+    // state workers
+    connect(ptr_db_export_worker, &db_export_worker::signal_update_state_workers,
+            state, &db_state_workers::slot_update_state_workers);
+    // request and result (mqtt)
+    connect(this, &db_manager::signal_reader_ctrl,
+            ptr_db_export_worker, &db_export_worker::slot_reader_ctrl);
+    connect(ptr_db_export_worker, &db_export_worker::signal_publish_message,
+            this, &db_manager::signal_publish_message);
+
+    ptr_db_export_thread = new QThread;
+    ptr_db_export_worker->moveToThread(ptr_db_export_thread);
+
+    ptr_db_export_thread->start();
+}
+
+void db_manager::create_event_detector_worker(db_state_workers *state)
+{
+    ptr_event_detector_worker = new event_detector_worker;
+    ptr_event_detector_worker->set_configuration(m_settings);
+
+    // add "event_detector_worker" to state monitor
+    state->add_name_workers(ptr_event_detector_worker->metaObject()->className());
+
+    // initialization
+    connect(this, &db_manager::signal_initialization_workers,
+            ptr_event_detector_worker, &event_detector_worker::slot_initialization);
+    // launching
+    connect(this, &db_manager::signal_launching_workers,
+            ptr_event_detector_worker, &event_detector_worker::slot_launching);
+    // stopping: db_manager::stopping() (blocking)
+
+    // state workers
+    connect(ptr_event_detector_worker, &event_detector_worker::signal_update_state_workers,
+            state, &db_state_workers::slot_update_state_workers);
+    // events (mqtt)
+    connect(ptr_event_detector_worker, &event_detector_worker::signal_publish_event,
+            this, &db_manager::signal_publish_event);
+
+    ptr_event_detector_thread = new QThread;
+    ptr_event_detector_worker->moveToThread(ptr_event_detector_thread);
+
+    ptr_event_detector_thread->start();
+}
+
 void db_manager::create_file_backup_worker(db_state_workers *state)
 {
     ptr_file_backup_workers = new file_backup_workers;
@@ -8,15 +8,21 @@
 #include "sweep_write_settings.h"
 #include "db_state_workers.h"
 #include "db_reader_worker.h"
+#include "db_export_worker.h"
 #include "db_writer_worker.h"
 #include "db_cleaner_workers.h"
 #include "file_backup_workers.h"
+#include "ingest_queue.h"
+#include "db_rollup_workers.h"
+#include "db_occupancy_workers.h"
+#include "detector/event_detector_worker.h"
 
 class db_manager : public QObject
 {
     Q_OBJECT
 public:
     explicit db_manager(QObject *parent = nullptr);
+    ~db_manager();
 
     void set_configuration(const sweep_write_settings &);
 
@@ -30,6 +36,8 @@ public slots:
     void slot_is_all_stopping_workers();
 
     void slot_received_data(const QByteArray &);
+    void slot_ingest_stat();
+    void slot_reader_ctrl(const QByteArray &);
 
     void slot_test_received_data();
 
@@ -38,9 +46,13 @@ signals:
     void signal_launching_workers();
     void signal_stopping_workers();
 
-    void signal_send_data_to_write(const QByteArray &);
+    void signal_process_queue();
     void signal_clean_db(const QString &);
 
+    void signal_reader_ctrl(const QByteArray &);
+    void signal_publish_message(const QByteArray &);
+    void signal_publish_event(const QByteArray &);
+
 private:
     bool is_ready;
     sweep_write_settings m_settings;    
@@ -48,16 +60,42 @@ private:
     // db state workers
     db_state_workers *ptr_db_state_workers {Q_NULLPTR};
 
-    // db write workers
-    db_writer_worker *ptr_db_writer_worker {Q_NULLPTR};
-    QPointer<QThread> ptr_db_writer_thread;
-    void create_db_writer_worker(db_state_workers *state);
+    // db write workers (one ingest queue per writer)
+    QList<db_writer_worker*> m_db_writer_workers;
+    QList<QPointer<QThread> > m_db_writer_threads;
+    QList<ingest_queue*> m_ingest_queues;
+    void create_db_writer_worker(db_state_workers *state, const int &index, const int &count);
+    int writer_index(const QByteArray &)const;
 
     // db clear workers
     db_cleaner_workers *ptr_db_cleaner_workers {Q_NULLPTR};
     QPointer<QThread> ptr_db_cleaner_thread;
     void create_db_cleaner_worker(db_state_workers *state);
 
+    // db rollup (per minute, per hour)
+    db_rollup_workers *ptr_db_rollup_workers {Q_NULLPTR};
+    QPointer<QThread> ptr_db_rollup_thread;
+    void create_db_rollup_worker(db_state_workers *state);
+
+    // occupancy statistics (ingest), served by db reader
+    db_occupancy_workers *ptr_db_occupancy_workers {Q_NULLPTR};
+    QPointer<QThread> ptr_db_occupancy_thread;
+    void create_db_occupancy_worker(db_state_workers *state);
+
+    db_reader_worker *ptr_db_reader_worker {Q_NULLPTR};
+    QPointer<QThread> ptr_db_reader_thread;
+    void create_db_reader_worker(db_state_workers *state);
+
+    // export of recorded sweeps (request of db reader)
+    db_export_worker *ptr_db_export_worker {Q_NULLPTR};
+    QPointer<QThread> ptr_db_export_thread;
+    void create_db_export_worker(db_state_workers *state);
+
+    // event detection (pipeline stage after the writers)
+    event_detector_worker *ptr_event_detector_worker {Q_NULLPTR};
+    QPointer<QThread> ptr_event_detector_thread;
+    void create_event_detector_worker(db_state_workers *state);
+
     // db file backup
     file_backup_workers *ptr_file_backup_workers {Q_NULLPTR};
     QPointer<QThread> ptr_file_backup_thread;
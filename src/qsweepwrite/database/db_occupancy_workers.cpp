@@ -0,0 +1,210 @@
+#include "db_occupancy_workers.h"
+#include "db_const.h"
+#include "db_statement.h"
+
+#include <QDateTime>
+#include <QtMath>
+#include <limits>
+
+#ifdef QT_DEBUG
+#include <QtCore/qdebug.h>
+#endif
+
+static int histogram_index(const float &value)
+{
+    const int index = static_cast<int>((value - occupancy_histogram_min)/occupancy_histogram_step);
+
+    return qBound(0, index, occupancy_histogram_size - 1);
+}
+
+void occupancy_bucket::reset(const QString &params_id, const qint64 &start, const quint64 &hz_low,
+                             const quint64 &hz_high, const qreal &fft_bin_width, const int &size)
+{
+    reset_layout(params_id, start, hz_low, hz_high, fft_bin_width, size);
+    m_above.fill(0, size);
+    m_sum.fill(0, size);
+    m_max.fill(std::numeric_limits<float>::lowest(), size);
+    m_histogram.fill(0, size*occupancy_histogram_size);
+}
+
+void occupancy_bucket::add(const QVector<float> &power, const float &threshold)
+{
+    const float *value = power.constData();
+    quint32 *value_above = m_above.data();
+    double *value_sum = m_sum.data();
+    float *value_max = m_max.data();
+    quint32 *histogram = m_histogram.data();
+
+    for(int i=0; i<power.size(); ++i)
+    {
+        if(value[i] > threshold)
+            value_above[i]++;
+
+        value_sum[i] += value[i];
+        value_max[i] = qMax(value_max[i], value[i]);
+        histogram[i*occupancy_histogram_size + histogram_index(value[i])]++;
+    }
+
+    m_count++;
+}
+
+QVector<float> occupancy_bucket::quantile(const qreal &q) const
+{
+    QVector<float> result(m_size);
+    const quint32 *histogram = m_histogram.constData();
+    const qint64 target = qMax<qint64>(1, qCeil(q*m_count));
+
+    for(int i=0; i<result.size(); ++i)
+    {
+        const quint32 *bin = histogram + i*occupancy_histogram_size;
+        qint64 total = 0;
+        int k = 0;
+
+        for(; k<occupancy_histogram_size - 1; ++k)
+        {
+            total += bin[k];
+
+            if(total >= target)
+                break;
+        }
+
+        // middle of the histogram cell
+        result[i] = occupancy_histogram_min + (k + 0.5f)*occupancy_histogram_step;
+    }
+
+    return result;
+}
+
+db_occupancy_workers::db_occupancy_workers(QObject *parent) : db_bucket_workers(parent)
+{
+    setObjectName(this->metaObject()->className());
+
+    m_dbase = QSqlDatabase::addDatabase(database_driver, connection_occupancy);
+}
+
+void db_occupancy_workers::slot_initialization()
+{
+    const QString db_name = m_settings.db_path().isEmpty()
+            ? stat_database_name : m_settings.db_path() + QDir::separator() + stat_database_name;
+
+    open_db(db_name);
+
+    if(is_open_db())
+    {
+        // db reader works with the same file
+        set_pragma("busy_timeout", "1000");
+
+        if(!is_table_name_resolve(spectr_occupancy_table))
+            create_table(spectr_occupancy_table);
+
+        QSqlQuery query(m_dbase);
+
+        if(!query.exec(create_index_sql(spectr_occupancy_table, "dt_start")))
+            update_last_error(&query);
+
+        // flush windows of params_id without new sweeps, retention
+        start_flush_timer(qMin(window_ms(), ms_in_minute));
+
+        emit signal_update_state_workers(state_workers::initialization);
+    }
+}
+
+void db_occupancy_workers::slot_stopping()
+{
+    const auto list_params = m_bucket.keys();
+
+    for(int i=0; i<list_params.size(); ++i)
+        flush_bucket(list_params.at(i));
+
+    emit signal_update_state_workers(state_workers::stopping);
+}
+
+void db_occupancy_workers::slot_data_spectr(const data_spectr &data)
+{
+    const spectr_frame frame = spectr_frame::from_data_spectr(data);
+
+    if(!frame.is_valid())
+        return;
+
+    const qint64 start = frame.m_time - frame.m_time%window_ms();
+    occupancy_bucket &bucket = m_bucket[frame.m_params_id];
+
+    if(bucket.is_stale(start, frame.m_hz_low, frame.m_hz_high, frame.m_power.size()))
+        flush_bucket(frame.m_params_id);
+
+    if(bucket.is_empty())
+        bucket.reset(frame.m_params_id, start, frame.m_hz_low, frame.m_hz_high,
+                     frame.m_fft_bin_width, frame.m_power.size());
+
+    bucket.add(frame.m_power, static_cast<float>(m_settings.occupancy_threshold()));
+}
+
+void db_occupancy_workers::flush_expired(const qint64 &now)
+{
+    const auto list_params = m_bucket.keys();
+
+    for(int i=0; i<list_params.size(); ++i)
+        if(m_bucket.value(list_params.at(i)).m_start + window_ms() <= now)
+            flush_bucket(list_params.at(i));
+}
+
+qint64 db_occupancy_workers::window_ms() const
+{
+    return qMax(1, m_settings.occupancy_window())*ms_in_second;
+}
+
+void db_occupancy_workers::flush_bucket(const QString &params_id)
+{
+    occupancy_bucket &bucket = m_bucket[params_id];
+
+    if(bucket.is_empty())
+        return;
+
+    write_bucket(bucket);
+
+    bucket.m_count = 0;
+}
+
+bool db_occupancy_workers::write_bucket(const occupancy_bucket &bucket)
+{
+    if(!is_open_db())
+        return false;
+
+    QVector<float> occupancy(bucket.m_above.size());
+    QVector<float> mean(bucket.m_sum.size());
+
+    for(int i=0; i<bucket.m_above.size(); ++i)
+    {
+        occupancy[i] = static_cast<float>(bucket.m_above.at(i))/bucket.m_count;
+        mean[i] = static_cast<float>(bucket.m_sum.at(i)/bucket.m_count);
+    }
+
+    insert_statement query(m_dbase, spectr_occupancy_table);
+    query.bind(query.index_of("params_id"), bucket.m_params_id);
+    query.bind(query.index_of("dt_start"), bucket.m_start);
+    query.bind(query.index_of("dt_window"), m_settings.occupancy_window());
+    query.bind(query.index_of("hz_low"), bucket.m_hz_low);
+    query.bind(query.index_of("hz_high"), bucket.m_hz_high);
+    query.bind(query.index_of("fft_bin_width"), bucket.m_fft_bin_width);
+    query.bind(query.index_of("threshold"), m_settings.occupancy_threshold());
+    query.bind(query.index_of("sweep_count"), bucket.m_count);
+    query.bind(query.index_of("data_occupancy"), float_array(occupancy));
+    query.bind(query.index_of("data_mean"), float_array(mean));
+    query.bind(query.index_of("data_max"), float_array(bucket.m_max));
+    query.bind(query.index_of("data_p50"), float_array(bucket.quantile(0.5)));
+    query.bind(query.index_of("data_p90"), float_array(bucket.quantile(0.9)));
+
+    if(query.exec())
+        return true;
+
+    update_last_error(query.query());
+
+    return false;
+}
+
+void db_occupancy_workers::apply_retention()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    delete_before(spectr_occupancy_table, now - m_settings.occupancy_retention()*ms_in_hour);
+}
@@ -0,0 +1,46 @@
+#ifndef DB_OCCUPANCY_WORKERS_H
+#define DB_OCCUPANCY_WORKERS_H
+
+#include "db_bucket_workers.h"
+
+// per bin statistics over one window: count above threshold, mean, max,
+// histogram (percentile sketch)
+struct occupancy_bucket : spectr_bucket
+{
+    QVector<quint32> m_above;
+    QVector<double> m_sum;
+    QVector<float> m_max;
+    QVector<quint32> m_histogram;   // bins * occupancy_histogram_size
+
+    void reset(const QString &params_id, const qint64 &start, const quint64 &hz_low,
+               const quint64 &hz_high, const qreal &fft_bin_width, const int &size);
+    void add(const QVector<float> &power, const float &threshold);
+    QVector<float> quantile(const qreal &q)const;
+};
+
+class db_occupancy_workers : public db_bucket_workers
+{
+    Q_OBJECT
+public:
+    explicit db_occupancy_workers(QObject *parent = nullptr);
+
+public slots:
+    void slot_initialization() Q_DECL_OVERRIDE;
+    void slot_stopping() Q_DECL_OVERRIDE;
+
+    void slot_data_spectr(const data_spectr &);
+
+protected:
+    void flush_expired(const qint64 &now) Q_DECL_OVERRIDE;
+    void apply_retention() Q_DECL_OVERRIDE;
+
+private:
+    // by params_id
+    QMap<QString, occupancy_bucket> m_bucket;
+
+    qint64 window_ms()const;
+    void flush_bucket(const QString &);
+    bool write_bucket(const occupancy_bucket &);
+};
+
+#endif // DB_OCCUPANCY_WORKERS_H
@@ -1,36 +1,132 @@
 #include "db_reader_worker.h"
+#include "db_const.h"
+
+#include <QSqlRecord>
+#include <limits>
+
+#include "sweep_message.h"
+#include "reader_ctrl.h"
+#include "occupancy_spectr.h"
 
 #ifdef QT_DEBUG
 #include <QtCore/qdebug.h>
 #endif
 
-db_reader_worker::db_reader_worker(QObject *parent) : QObject(parent)
+static QVector<qreal> float_values(const QByteArray &blob)
 {
-    setObjectName(this->metaObject()->className());
+    const int size = blob.size()/static_cast<int>(sizeof(float));
+    const float *value = reinterpret_cast<const float*>(blob.constData());
+
+    QVector<qreal> values(size);
+
+    for(int i=0; i<size; ++i)
+        values[i] = static_cast<qreal>(value[i]);
+
+    return values;
 }
 
-void db_reader_worker::set_configuration(const sweep_write_settings &settings)
+db_reader_worker::db_reader_worker(QObject *parent) : db_custom_workers(parent)
 {
-    m_settings = settings;
+    setObjectName(this->metaObject()->className());
+
+    m_dbase = QSqlDatabase::addDatabase(database_driver, connection_read);
 }
 
 void db_reader_worker::slot_initialization()
 {
-    // to do
+    const QString db_name = m_settings.db_path().isEmpty()
+            ? stat_database_name : m_settings.db_path() + QDir::separator() + stat_database_name;
 
-    emit signal_update_state_workers(state_workers::initialization);
-}
+    open_db(db_name);
 
-void db_reader_worker::slot_launching()
-{
-    // to do
+    if(is_open_db())
+    {
+        // statistics are written by another connection
+        set_pragma("busy_timeout", "1000");
+        set_pragma("query_only", "1");
 
-    emit signal_update_state_workers(state_workers::launching);
+        emit signal_update_state_workers(state_workers::initialization);
+    }
 }
 
 void db_reader_worker::slot_stopping()
 {
-    // to do
+    close_db();
 
     emit signal_update_state_workers(state_workers::stopping);
 }
+
+void db_reader_worker::slot_reader_ctrl(const QByteArray &json)
+{
+    const reader_ctrl ctrl(json);
+
+    if(!ctrl.is_valid())
+        return;
+
+    if(ctrl.ctrl_type() == reader_ctrl_type::occupancy)
+        read_occupancy(ctrl);
+}
+
+void db_reader_worker::read_occupancy(const reader_ctrl &ctrl)
+{
+    if(!is_open_db())
+        return;
+
+    const bool by_params = !ctrl.id_params().isEmpty();
+
+    QSqlQuery query(m_dbase);
+    query.setForwardOnly(true);
+    query.prepare(select_range_sql(spectr_occupancy_table, "dt_start", by_params));
+    query.bindValue(":from", ctrl.dt_from().isValid() ? ctrl.dt_from().toMSecsSinceEpoch() : 0);
+    query.bindValue(":to", ctrl.dt_to().isValid() ? ctrl.dt_to().toMSecsSinceEpoch()
+                                                  : std::numeric_limits<qint64>::max());
+    query.bindValue(":limit", ctrl.limit() > 0 ? ctrl.limit() : reader_row_limit);
+
+    if(by_params)
+        query.bindValue(":params_id", ctrl.id_params());
+
+    if(!query.exec())
+    {
+        update_last_error(&query);
+        return;
+    }
+
+    const QSqlRecord record = query.record();
+    const int field_params_id = record.indexOf("params_id");
+    const int field_dt_start = record.indexOf("dt_start");
+    const int field_dt_window = record.indexOf("dt_window");
+    const int field_hz_low = record.indexOf("hz_low");
+    const int field_hz_high = record.indexOf("hz_high");
+    const int field_fft_bin_width = record.indexOf("fft_bin_width");
+    const int field_threshold = record.indexOf("threshold");
+    const int field_sweep_count = record.indexOf("sweep_count");
+    const int field_occupancy = record.indexOf("data_occupancy");
+    const int field_mean = record.indexOf("data_mean");
+    const int field_max = record.indexOf("data_max");
+    const int field_p50 = record.indexOf("data_p50");
+    const int field_p90 = record.indexOf("data_p90");
+
+    while(query.next())
+    {
+        occupancy_spectr occupancy;
+        occupancy.set_id_params(query.value(field_params_id).toString());
+        occupancy.set_date_time(QDateTime::fromMSecsSinceEpoch(query.value(field_dt_start).toLongLong(), Qt::UTC));
+        occupancy.set_window(query.value(field_dt_window).toInt());
+        occupancy.set_hz_low(query.value(field_hz_low).toULongLong());
+        occupancy.set_hz_high(query.value(field_hz_high).toULongLong());
+        occupancy.set_fft_bin_width(query.value(field_fft_bin_width).toDouble());
+        occupancy.set_threshold(query.value(field_threshold).toDouble());
+        occupancy.set_sweep_count(query.value(field_sweep_count).toLongLong());
+        occupancy.set_occupancy(float_values(query.value(field_occupancy).toByteArray()));
+        occupancy.set_mean(float_values(query.value(field_mean).toByteArray()));
+        occupancy.set_max(float_values(query.value(field_max).toByteArray()));
+        occupancy.set_p50(float_values(query.value(field_p50).toByteArray()));
+        occupancy.set_p90(float_values(query.value(field_p90).toByteArray()));
+
+        sweep_message send_data;
+        send_data.set_type(type_message::data_occupancy);
+        send_data.set_data_message(occupancy.to_json());
+
+        emit signal_publish_message(send_data.to_json());
+    }
+}
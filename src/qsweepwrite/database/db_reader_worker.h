@@ -1,34 +1,29 @@
 #ifndef DB_READER_WORKER_H
 #define DB_READER_WORKER_H
 
-#include <QObject>
-#include <QSqlDatabase>
-#include <QSqlQuery>
+#include "db_custom_workers.h"
 
-#include "sweep_write_settings.h"
-#include "db_state_workers.h"
+class reader_ctrl;
 
-class db_reader_worker : public QObject
+class db_reader_worker : public db_custom_workers
 {
     Q_OBJECT
 public:
     explicit db_reader_worker(QObject *parent = nullptr);
 
-    void set_configuration(const sweep_write_settings &);
-
 public slots:
-    void slot_initialization();
-    void slot_launching();
-    void slot_stopping();
+    void slot_initialization() Q_DECL_OVERRIDE;
+    void slot_stopping() Q_DECL_OVERRIDE;
+
+    // request (reader_ctrl json)
+    void slot_reader_ctrl(const QByteArray &);
 
 signals:
-    void signal_update_state_workers(const state_workers &type);
+    // result (sweep_message json)
+    void signal_publish_message(const QByteArray &);
 
 private:
-    QSqlDatabase m_dbase;
-    QString m_str_error_dbase;
-
-    sweep_write_settings m_settings;
+    void read_occupancy(const reader_ctrl &);
 };
 
 #endif // DB_READER_WORKER_H
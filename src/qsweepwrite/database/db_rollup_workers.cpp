@@ -0,0 +1,211 @@
+#include "db_rollup_workers.h"
+#include "db_const.h"
+#include "db_statement.h"
+
+#include <QDateTime>
+#include <limits>
+
+#ifdef QT_DEBUG
+#include <QtCore/qdebug.h>
+#endif
+
+void rollup_bucket::reset(const QString &params_id, const qint64 &start, const quint64 &hz_low,
+                          const quint64 &hz_high, const qreal &fft_bin_width, const int &size)
+{
+    reset_layout(params_id, start, hz_low, hz_high, fft_bin_width, size);
+    m_min.fill(std::numeric_limits<float>::max(), size);
+    m_max.fill(std::numeric_limits<float>::lowest(), size);
+    m_sum.fill(0, size);
+}
+
+void rollup_bucket::add(const QVector<float> &power)
+{
+    const float *value = power.constData();
+    float *value_min = m_min.data();
+    float *value_max = m_max.data();
+    double *value_sum = m_sum.data();
+
+    for(int i=0; i<power.size(); ++i)
+    {
+        value_min[i] = qMin(value_min[i], value[i]);
+        value_max[i] = qMax(value_max[i], value[i]);
+        value_sum[i] += value[i];
+    }
+
+    m_count++;
+}
+
+void rollup_bucket::add(const rollup_bucket &bucket)
+{
+    for(int i=0; i<bucket.m_min.size(); ++i)
+    {
+        m_min[i] = qMin(m_min.at(i), bucket.m_min.at(i));
+        m_max[i] = qMax(m_max.at(i), bucket.m_max.at(i));
+        m_sum[i] += bucket.m_sum.at(i);
+    }
+
+    m_count += bucket.m_count;
+}
+
+db_rollup_workers::db_rollup_workers(QObject *parent) : db_bucket_workers(parent)
+{
+    setObjectName(this->metaObject()->className());
+
+    m_dbase = QSqlDatabase::addDatabase(database_driver, connection_rollup);
+}
+
+void db_rollup_workers::slot_initialization()
+{
+    const QString db_name = m_settings.db_path().isEmpty()
+            ? rollup_database_name : m_settings.db_path() + QDir::separator() + rollup_database_name;
+
+    open_db(db_name);
+
+    if(is_open_db())
+    {
+        const auto list_table = rollup_table.keys();
+
+        for(int i=0; i<list_table.size(); ++i)
+        {
+            if(!is_table_name_resolve(list_table.at(i)))
+                create_table(list_table.at(i));
+
+            QSqlQuery query(m_dbase);
+
+            if(!query.exec(create_index_sql(list_table.at(i), "dt_start")))
+                update_last_error(&query);
+        }
+
+        // flush buckets of params_id without new sweeps, retention
+        start_flush_timer(ms_in_minute);
+
+        emit signal_update_state_workers(state_workers::initialization);
+    }
+}
+
+void db_rollup_workers::slot_stopping()
+{
+    const auto list_minute = m_minute.keys();
+
+    for(int i=0; i<list_minute.size(); ++i)
+        flush_minute(list_minute.at(i));
+
+    const auto list_hour = m_hour.keys();
+
+    for(int i=0; i<list_hour.size(); ++i)
+        flush_hour(list_hour.at(i));
+
+    emit signal_update_state_workers(state_workers::stopping);
+}
+
+void db_rollup_workers::slot_data_spectr(const data_spectr &data)
+{
+    const spectr_frame frame = spectr_frame::from_data_spectr(data);
+
+    if(frame.is_valid())
+        add_frame(frame);
+}
+
+void db_rollup_workers::flush_expired(const qint64 &now)
+{
+    const auto list_minute = m_minute.keys();
+
+    for(int i=0; i<list_minute.size(); ++i)
+        if(m_minute.value(list_minute.at(i)).m_start + ms_in_minute <= now)
+            flush_minute(list_minute.at(i));
+
+    const auto list_hour = m_hour.keys();
+
+    for(int i=0; i<list_hour.size(); ++i)
+        if(m_hour.value(list_hour.at(i)).m_start + ms_in_hour <= now)
+            flush_hour(list_hour.at(i));
+}
+
+void db_rollup_workers::add_frame(const spectr_frame &frame)
+{
+    const qint64 start = frame.m_time - frame.m_time%ms_in_minute;
+    rollup_bucket &bucket = m_minute[frame.m_params_id];
+
+    if(bucket.is_stale(start, frame.m_hz_low, frame.m_hz_high, frame.m_power.size()))
+        flush_minute(frame.m_params_id);
+
+    if(bucket.is_empty())
+        bucket.reset(frame.m_params_id, start, frame.m_hz_low, frame.m_hz_high,
+                     frame.m_fft_bin_width, frame.m_power.size());
+
+    bucket.add(frame.m_power);
+}
+
+void db_rollup_workers::flush_minute(const QString &params_id)
+{
+    rollup_bucket &bucket = m_minute[params_id];
+
+    if(bucket.is_empty())
+        return;
+
+    write_bucket(spectr_rollup_minute_table, bucket);
+
+    // hour tier is computed from minute buckets
+    const qint64 start = bucket.m_start - bucket.m_start%ms_in_hour;
+    rollup_bucket &hour = m_hour[params_id];
+
+    if(hour.is_stale(start, bucket.m_hz_low, bucket.m_hz_high, bucket.m_size))
+        flush_hour(params_id);
+
+    if(hour.is_empty())
+        hour.reset(params_id, start, bucket.m_hz_low, bucket.m_hz_high,
+                   bucket.m_fft_bin_width, bucket.m_size);
+
+    hour.add(bucket);
+
+    bucket.m_count = 0;
+}
+
+void db_rollup_workers::flush_hour(const QString &params_id)
+{
+    rollup_bucket &bucket = m_hour[params_id];
+
+    if(bucket.is_empty())
+        return;
+
+    write_bucket(spectr_rollup_hour_table, bucket);
+
+    bucket.m_count = 0;
+}
+
+bool db_rollup_workers::write_bucket(const QString &table_name, const rollup_bucket &bucket)
+{
+    if(!is_open_db())
+        return false;
+
+    QVector<float> mean(bucket.m_sum.size());
+
+    for(int i=0; i<bucket.m_sum.size(); ++i)
+        mean[i] = static_cast<float>(bucket.m_sum.at(i)/bucket.m_count);
+
+    insert_statement query(m_dbase, table_name);
+    query.bind(query.index_of("params_id"), bucket.m_params_id);
+    query.bind(query.index_of("dt_start"), bucket.m_start);
+    query.bind(query.index_of("hz_low"), bucket.m_hz_low);
+    query.bind(query.index_of("hz_high"), bucket.m_hz_high);
+    query.bind(query.index_of("fft_bin_width"), bucket.m_fft_bin_width);
+    query.bind(query.index_of("sweep_count"), bucket.m_count);
+    query.bind(query.index_of("data_min"), float_array(bucket.m_min));
+    query.bind(query.index_of("data_mean"), float_array(mean));
+    query.bind(query.index_of("data_max"), float_array(bucket.m_max));
+
+    if(query.exec())
+        return true;
+
+    update_last_error(query.query());
+
+    return false;
+}
+
+void db_rollup_workers::apply_retention()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    delete_before(spectr_rollup_minute_table, now - m_settings.rollup_minute_retention()*ms_in_hour);
+    delete_before(spectr_rollup_hour_table, now - m_settings.rollup_hour_retention()*ms_in_hour);
+}
@@ -0,0 +1,46 @@
+#ifndef DB_ROLLUP_WORKERS_H
+#define DB_ROLLUP_WORKERS_H
+
+#include "db_bucket_workers.h"
+
+// min/mean/max per bin over one time bucket
+struct rollup_bucket : spectr_bucket
+{
+    QVector<float> m_min;
+    QVector<float> m_max;
+    QVector<double> m_sum;
+
+    void reset(const QString &params_id, const qint64 &start, const quint64 &hz_low,
+               const quint64 &hz_high, const qreal &fft_bin_width, const int &size);
+    void add(const QVector<float> &power);
+    void add(const rollup_bucket &bucket);
+};
+
+class db_rollup_workers : public db_bucket_workers
+{
+    Q_OBJECT
+public:
+    explicit db_rollup_workers(QObject *parent = nullptr);
+
+public slots:
+    void slot_initialization() Q_DECL_OVERRIDE;
+    void slot_stopping() Q_DECL_OVERRIDE;
+
+    void slot_data_spectr(const data_spectr &);
+
+protected:
+    void flush_expired(const qint64 &now) Q_DECL_OVERRIDE;
+    void apply_retention() Q_DECL_OVERRIDE;
+
+private:
+    // by params_id
+    QMap<QString, rollup_bucket> m_minute;
+    QMap<QString, rollup_bucket> m_hour;
+
+    void add_frame(const spectr_frame &);
+    void flush_minute(const QString &);
+    void flush_hour(const QString &);
+    bool write_bucket(const QString &table_name, const rollup_bucket &);
+};
+
+#endif // DB_ROLLUP_WORKERS_H
@@ -1,13 +1,10 @@
 #include "db_state_workers.h"
 
 #include <QTimer>
+#include <QtCore/qdebug.h>
 
 #include "db_const.h"
 
-#ifdef QT_DEBUG
-#include <QtCore/qdebug.h>
-#endif
-
 db_state_workers::db_state_workers(QObject *parent) : QObject(parent)
 {
     m_timer_writed = new QTimer;
@@ -18,6 +15,11 @@ void db_state_workers::add_name_workers(const QString &name)
     m_workers_state.insert(name, state_workers::unknown);
 }
 
+void db_state_workers::set_data_backup(const bool &value)
+{
+    is_data_backup = value;
+}
+
 void db_state_workers::slot_update_state_workers(const state_workers &type)
 {
     QObject* sender_state = qobject_cast<QObject*>(sender());
@@ -59,9 +61,9 @@ void db_state_workers::slot_state_db(const QString &db_name, const state_db &sta
 {
     m_state_db.insert(db_name, state);
 
-    // file backup
-    if((state==state_db::file_is_full)&&(m_state_db.contains(db_name)))
-        emit signal_file_to_backup(db_name);
+    // file backup (full chunks found on startup wait for launching)
+    if((state==state_db::file_is_full)&&is_launched)
+        file_is_full(db_name);
 
     // file data clean
     if((state==state_db::file_is_backup)&&(m_state_db.contains(db_name)))
@@ -72,6 +74,50 @@ void db_state_workers::slot_state_db(const QString &db_name, const state_db &sta
         emit signal_file_is_ready(db_name);
 }
 
+void db_state_workers::slot_recycle_time(const QString &db_name, const qint64 &elapsed)
+{
+    recycle_stat &stat = m_recycle_stat[db_name];
+    stat.m_last = elapsed;
+    stat.m_max = qMax(stat.m_max, elapsed);
+    stat.m_count++;
+
+    // once per chunk rotation, also in release builds
+    qInfo() << "recycle:" << db_name
+            << QString("time elapsed: %1 ms (max: %2 ms, recycles: %3)")
+               .arg(stat.m_last).arg(stat.m_max).arg(stat.m_count);
+}
+
+void db_state_workers::slot_ingest_stat(const QString &name, const ingest_queue_stat &stat)
+{
+#ifdef QT_DEBUG
+    if(stat.m_received != m_ingest_stat.value(name).m_received)
+        qDebug() << "ingest queue:" << name
+                 << "depth" << stat.m_depth
+                 << "high water" << stat.m_high_water
+                 << "received" << stat.m_received
+                 << "dropped" << stat.m_dropped
+                 << "spilled" << stat.m_spilled
+                 << "replayed" << stat.m_replayed
+                 << "journal" << stat.m_journal;
+#endif
+
+    m_ingest_stat.insert(name, stat);
+}
+
+void db_state_workers::slot_active_chunk(const QString &db_name)
+{
+    QObject* sender_state = qobject_cast<QObject*>(sender());
+
+    if(sender_state != Q_NULLPTR)
+    {
+        m_active_chunk.insert(sender_state->objectName(), db_name);
+
+#ifdef QT_DEBUG
+        qDebug() << "active chunks:" << m_active_chunk;
+#endif
+    }
+}
+
 void db_state_workers::is_all_initialization()
 {
     const auto list_state = m_workers_state.values();
@@ -97,6 +143,17 @@ void db_state_workers::is_all_launching()
     if(counter==list_state.size())
     {
         m_timer_writed->start();
+
+        if(!is_launched)
+        {
+            is_launched = true;
+
+            const auto list_file_is_full = m_state_db.keys(state_db::file_is_full);
+
+            for(int i=0; i<list_file_is_full.size(); ++i)
+                file_is_full(list_file_is_full.at(i));
+        }
+
         emit signal_all_launching();
     }
 
@@ -112,6 +169,14 @@ void db_state_workers::is_all_launching()
 //    }
 }
 
+void db_state_workers::file_is_full(const QString &db_name)
+{
+    if(is_data_backup)
+        emit signal_file_to_backup(db_name);
+    else
+        emit signal_start_cleaner(db_name);
+}
+
 void db_state_workers::is_all_stopping()
 {
     const auto list_state = m_workers_state.values();
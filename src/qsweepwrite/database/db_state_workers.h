@@ -4,6 +4,8 @@
 #include <QObject>
 #include <QMap>
 
+#include "ingest_queue.h"
+
 class QTimer;
 
 enum state_workers: qint32 {
@@ -28,6 +30,14 @@ enum state_db: qint32 {
 
 Q_DECLARE_METATYPE(state_db)
 
+// chunk recycle time (ms) by chunk
+struct recycle_stat
+{
+    qint64 m_last = 0;
+    qint64 m_max = 0;
+    qint64 m_count = 0;         // recycles
+};
+
 class db_state_workers : public QObject
 {
     Q_OBJECT
@@ -35,6 +45,7 @@ public:
     explicit db_state_workers(QObject *parent = nullptr);
 
     void add_name_workers(const QString &name);
+    void set_data_backup(const bool &);
 
 signals:
     void signal_all_initialization();
@@ -48,16 +59,26 @@ public slots:
     void slot_update_state_workers(const state_workers &type);
     void slot_db_size(const QString &, const qint64 &);
     void slot_state_db(const QString &, const state_db &);
+    void slot_recycle_time(const QString &, const qint64 &);
+    void slot_ingest_stat(const QString &, const ingest_queue_stat &);
+    void slot_active_chunk(const QString &);
 
 private:
+    bool is_launched {false};
+    bool is_data_backup {false};
     QTimer *m_timer_writed {Q_NULLPTR};
     QMap<QString, state_workers> m_workers_state;
     QMap <QString, qint64> m_db_file_size;
     QMap <QString, state_db> m_state_db;
+    QMap <QString, recycle_stat> m_recycle_stat;
+    // by db writer name
+    QMap <QString, ingest_queue_stat> m_ingest_stat;
+    QMap <QString, QString> m_active_chunk;
 
     void is_all_initialization();
     void is_all_launching();
     void is_all_stopping();
+    void file_is_full(const QString &);
 };
 
 #endif // DB_STATE_WORKERS_H
@@ -0,0 +1,87 @@
+#include "db_statement.h"
+
+insert_statement::insert_statement(const QSqlDatabase &db, const QString &table_name) :
+    m_schema(schema_of(table_name)),
+    m_query(db)
+{
+    if(m_schema.is_valid())
+        m_prepared = m_query.prepare(m_schema.m_insert_sql);
+}
+
+int insert_statement::index_of(const QString &column) const
+{
+    return m_schema.insert_index(column);
+}
+
+void insert_statement::bind(const int &index, const QVariant &value)
+{
+    if(index >= 0)
+        m_query.bindValue(index, value);
+}
+
+bool insert_statement::exec()
+{
+    if(!m_prepared)
+        return false;
+
+    return m_query.exec();
+}
+
+spectr_data_insert::spectr_data_insert(const QSqlDatabase &db) :
+    insert_statement(db, spectr_data_table),
+    m_params_id(index_of("params_id")),
+    m_data_spectr(index_of("data_spectr"))
+{
+}
+
+bool spectr_data_insert::exec(const QString &params_id, const QByteArray &data_spectr)
+{
+    bind(m_params_id, params_id);
+    bind(m_data_spectr, data_spectr);
+
+    return insert_statement::exec();
+}
+
+spectr_params_insert::spectr_params_insert(const QSqlDatabase &db) :
+    insert_statement(db, spectr_params_table),
+    m_params_id(index_of("params_id")),
+    m_data_params(index_of("data_params"))
+{
+}
+
+bool spectr_params_insert::exec(const QString &params_id, const QByteArray &data_params)
+{
+    bind(m_params_id, params_id);
+    bind(m_data_params, data_params);
+
+    return insert_statement::exec();
+}
+
+bool schema_cache::contains(const QSqlDatabase &db, const QString &table_name)
+{
+    if(!m_loaded)
+    {
+        QSqlQuery query(db);
+
+        if(!query.exec("SELECT name FROM sqlite_master WHERE type = 'table';"))
+            return false;
+
+        while(query.next())
+            m_tables.insert(query.value(0).toString().toLower());
+
+        m_loaded = true;
+    }
+
+    return m_tables.contains(table_name.toLower());
+}
+
+void schema_cache::insert(const QString &table_name)
+{
+    m_tables.insert(table_name.toLower());
+}
+
+void schema_cache::clear()
+{
+    m_tables.clear();
+    m_loaded = false;
+}
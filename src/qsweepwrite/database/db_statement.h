@@ -0,0 +1,70 @@
+#ifndef DB_STATEMENT_H
+#define DB_STATEMENT_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSet>
+
+#include "db_const.h"
+
+// INSERT of one table, prepared once per open connection and reused.
+// Values are bound by position (table_schema::m_insert_columns), the
+// statement must be destroyed before its connection is closed
+class insert_statement
+{
+public:
+    insert_statement(const QSqlDatabase &db, const QString &table_name);
+
+    bool is_prepared()const { return m_prepared; }
+    QSqlQuery *query() { return &m_query; }
+
+    // -1 if the table has no such column
+    int index_of(const QString &column)const;
+    void bind(const int &index, const QVariant &value);
+    bool exec();
+
+private:
+    const table_schema &m_schema;
+    QSqlQuery m_query;
+    bool m_prepared {false};
+};
+
+// spectr_data_table
+class spectr_data_insert : public insert_statement
+{
+public:
+    explicit spectr_data_insert(const QSqlDatabase &db);
+    bool exec(const QString &params_id, const QByteArray &data_spectr);
+
+private:
+    const int m_params_id;
+    const int m_data_spectr;
+};
+
+// spectr_params_table
+class spectr_params_insert : public insert_statement
+{
+public:
+    explicit spectr_params_insert(const QSqlDatabase &db);
+    bool exec(const QString &params_id, const QByteArray &data_params);
+
+private:
+    const int m_params_id;
+    const int m_data_params;
+};
+
+// tables of an open connection: sqlite_master is read once per open,
+// tables created afterwards are added by the owner
+class schema_cache
+{
+public:
+    bool contains(const QSqlDatabase &db, const QString &table_name);
+    void insert(const QString &table_name);
+    void clear();
+
+private:
+    QSet<QString> m_tables;     // lower case
+    bool m_loaded {false};
+};
+
+#endif // DB_STATEMENT_H
@@ -1,10 +1,12 @@
 #include "db_writer_worker.h"
 #include "db_const.h"
+#include "ingest_queue.h"
+#include "storage_backend.h"
 
-#include <QSqlRecord>
-#include <QSqlError>
 #include <QFileInfo>
-#include <QTimer>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include "sweep_message.h"
 
@@ -15,13 +17,35 @@
 db_writer_worker::db_writer_worker(QObject *parent) : QObject(parent)
 {
     setObjectName(this->metaObject()->className());
+}
 
-    m_dbase = QSqlDatabase::addDatabase(database_driver, connection_write);
+db_writer_worker::~db_writer_worker()
+{
+}
+
+void db_writer_worker::set_writer_index(const int &index, const int &count)
+{
+    m_writer_index = index;
+    m_writer_count = qMax(1, count);
+
+    if(m_writer_index > 0)
+        setObjectName(QString("%1_%2").arg(this->metaObject()->className()).arg(m_writer_index));
 }
 
 void db_writer_worker::set_configuration(const sweep_write_settings &settings)
 {
     m_settings = settings;
+
+    // sqlite connection is created here (before moveToThread)
+    const QString connection_name = (m_writer_index > 0)
+            ? QString("%1_%2").arg(connection_write).arg(m_writer_index) : connection_write;
+
+    ptr_storage.reset(create_storage_backend(m_settings.storage(), connection_name));
+}
+
+void db_writer_worker::set_ingest_queue(ingest_queue *queue)
+{
+    ptr_ingest_queue = queue;
 }
 
 void db_writer_worker::slot_initialization()
@@ -33,11 +57,38 @@ void db_writer_worker::slot_initialization()
 
     if(dir.exists())
     {
-        QStringList list_file(list_of_all_chunk_files(m_settings.db_path(), m_settings.db_file_count()));
+        QStringList list_file(list_of_all_chunk_files(m_settings.db_path(), m_settings.db_file_count(),
+                                                      chunk_file_template(m_settings.storage())));
+
+        QStringList list_own_file;
+
+        for(int i=m_writer_index; i<list_file.size(); i+=m_writer_count)
+            list_own_file.append(list_file.at(i));
 
-        for(int i=0; i<list_file.size(); ++i)
+        // recovery: check existing chunks in parallel, broken chunks are recreated
+        QElapsedTimer recovery_time;
+        recovery_time.start();
+
+        QMap<QString, QFuture<bool> > list_check;
+
+        for(int i=0; i<list_own_file.size(); ++i)
+            if(QFile::exists(list_own_file.at(i)))
+                list_check.insert(list_own_file.at(i),
+                                  QtConcurrent::run(check_chunk_file, m_settings.storage(), list_own_file.at(i)));
+
+        for(int i=0; i<list_own_file.size(); ++i)
         {
-            const QString tmp_db_name = list_file.at(i);
+            const QString tmp_db_name = list_own_file.at(i);
+
+            if(list_check.contains(tmp_db_name)&&(!list_check[tmp_db_name].result()))
+            {
+#ifdef QT_DEBUG
+                qWarning() << "chunk is broken, recreate:" << tmp_db_name;
+#endif
+                QFile::remove(tmp_db_name + "-journal");
+                QFile::remove(tmp_db_name);
+            }
+
             m_init_db_file_status.insert(tmp_db_name, false);
 
             m_db_file_state.insert(tmp_db_name, state_db::file_unknown);
@@ -46,17 +97,21 @@ void db_writer_worker::slot_initialization()
             // create or open (test)
             open_db(tmp_db_name);
 
-            // clear data
-            //clean_file_db(tmp_db_name);
-
+            // full / ready
             update_size_file(tmp_db_name);
 
-            m_init_db_file_status.insert(tmp_db_name, m_dbase.isOpen());
+            m_init_db_file_status.insert(tmp_db_name, ptr_storage->is_open()||(m_db_file_state.value(tmp_db_name) == state_db::file_is_full));
 
-            if(m_dbase.isOpen())
+            if(ptr_storage->is_open())
                 close_db();
         }
 
+#ifdef QT_DEBUG
+        qInfo() << "chunks:" << list_own_file.size()
+                << "full:" << m_db_file_state.keys(state_db::file_is_full).size()
+                << QString("Recovery time elapsed: %1 ms").arg(recovery_time.elapsed());
+#endif
+
         const auto is_state_list = m_init_db_file_status.values();
 
         if(!is_state_list.contains(false))
@@ -73,10 +128,14 @@ void db_writer_worker::slot_launching()
 {
     close_db();
 
-    open_db(file_selection_for_writing());
+    // resume the most recent chunk
+    open_db(file_selection_for_resume());
 
-    if(m_dbase.isOpen())
+    if(ptr_storage->is_open())
+    {
+        emit signal_active_chunk(ptr_storage->file_name());
         emit signal_update_state_workers(state_workers::launching);
+    }
 }
 
 void db_writer_worker::slot_stopping()
@@ -86,6 +145,22 @@ void db_writer_worker::slot_stopping()
     emit signal_update_state_workers(state_workers::stopping);
 }
 
+void db_writer_worker::slot_process_queue()
+{
+    if(ptr_ingest_queue)
+    {
+        QVector<QByteArray> batch;
+        const bool is_more = ptr_ingest_queue->take_batch(ingest_batch_size, batch);
+
+        for(int i=0; i<batch.size(); ++i)
+            slot_data_to_write(batch.at(i));
+
+        // return to the event loop between batches (state signals)
+        if(is_more)
+            QMetaObject::invokeMethod(this, "slot_process_queue", Qt::QueuedConnection);
+    }
+}
+
 void db_writer_worker::slot_data_to_write(const QByteArray &rc_data)
 {
     const sweep_message data_received(rc_data);
@@ -94,8 +169,16 @@ void db_writer_worker::slot_data_to_write(const QByteArray &rc_data)
     {
         if(data_received.type() == type_message::data_spectr)
         {
-            const data_spectr rc_data_spectr(data_received.data_message());
+            data_spectr rc_data_spectr(data_received.data_message());
+
+            // sparse update: full sweep is stored
+            if(!m_sparse_decoder.decode(rc_data_spectr))
+                return;
+
             data_spectr_to_write(rc_data_spectr);
+
+            // rollup, statistics (parsed once)
+            emit signal_data_spectr(rc_data_spectr);
         }
 
         if(data_received.type() == type_message::ctrl_spectr)
@@ -108,6 +191,10 @@ void db_writer_worker::slot_data_to_write(const QByteArray &rc_data)
 
 void db_writer_worker::slot_file_is_ready(const QString &db_name)
 {
+    // chunk of another writer
+    if(!m_db_file_state.contains(db_name))
+        return;
+
     if(m_db_file_state.value(db_name)!=state_db::file_is_ready)
     {
 
@@ -124,155 +211,30 @@ void db_writer_worker::slot_file_is_ready(const QString &db_name)
 
 void db_writer_worker::open_db(const QString &db_name)
 {
-    m_dbase.setDatabaseName(db_name);
-
-    if(m_dbase.open())
+    if(!ptr_storage->open(db_name))
     {
-        //PRAGMA page_size = bytes; // размер страницы БД; страница БД - это единица обмена между диском и кэшом, разумно сделать равным размеру кластера диска (у меня 4096)
-        //PRAGMA cache_size = -kibibytes; // задать размер кэша соединения в килобайтах, по умолчанию он равен 2000 страниц БД
-        //PRAGMA encoding = "UTF-8";  // тип данных БД, всегда используйте UTF-8
-        //PRAGMA foreign_keys = 1; // включить поддержку foreign keys, по умолчанию - ОТКЛЮЧЕНА
-        //PRAGMA journal_mode = DELETE | TRUNCATE | PERSIST | MEMORY | WAL | OFF;  // задать тип журнала, см. далее
-        //PRAGMA synchronous = 0 | OFF | 1 | NORMAL | 2 | FULL; // тип синхронизации транзакции, см. далее
-        //PRAGMA schema.auto_vacuum = 0 | NONE | 1 | FULL | 2 | INCREMENTAL;
-
-        set_pragma("synchronous", "0");
-        set_pragma("auto_vacuum", "1");
-
-        const auto list_table = table.keys();
-
-        for(int i=0; i<list_table.size(); i++)
-            if(!is_table_name_resolve(list_table.at(i)))
-                create_table(list_table.at(i));
-
-    }else{
 #ifdef QT_DEBUG
-        qDebug() << "Can't database open:" << db_name;
-        qDebug() << "Error:" << m_dbase.lastError();
+        qDebug() << "Can't chunk open:" << db_name;
+        qDebug() << "Error:" << ptr_storage->last_error();
 #endif
     }
 }
 
-bool db_writer_worker::start_transaction()
-{
-    bool on(false);
-    if(m_dbase.isOpen())
-        on = m_dbase.transaction();
-    return on;
-}
-
-bool db_writer_worker::commit_transaction()
-{
-    bool on(false);
-    if(m_dbase.isOpen())
-        on = m_dbase.commit();
-    return on;
-}
-
-void db_writer_worker::set_pragma(const QString &param, const QString &value)
-{
-    QString sql_query(pragma_sql(param, value));
-
-    if (m_dbase.isOpen())
-    {
-        QSqlQuery* query = new QSqlQuery(m_dbase);
-        query->prepare(sql_query);
-
-        if(!query->exec())
-            update_last_error(query);
-    }
-}
-
-bool db_writer_worker::is_table_name_resolve(const QString &table_name)
-{
-    if(m_dbase.isOpen()&&(!table_name.isEmpty()))
-    {
-        QSqlQuery* query = new QSqlQuery(m_dbase);
-        QString str_sql = QString("SELECT name FROM sqlite_master WHERE type =:table AND name = '%1' ").arg(table_name);
-        query->prepare(str_sql);
-        query->bindValue(":table", "table");
-        if(!query->exec())
-            update_last_error(query);
-        int field_no = query->record().indexOf("name");
-
-        while (query->next()) {
-            QString _name = query->value(field_no).toString();
-
-            // если таблица существует
-            if(_name.contains(table_name, Qt::CaseInsensitive))
-                return true;
-        }
-        return false;
-    }
-    return false;
-}
-
-bool db_writer_worker::create_table(const QString &table_name) const
-{
-    if(m_dbase.isOpen()&&(!table_name.isEmpty()))
-    {
-        QSqlQuery query(m_dbase);
-        QString sql = create_table_sql(table_name);
-
-        if(query.exec(sql)){
-#ifdef QT_DEBUG
-            qDebug() << "create table:" << table_name;
-#endif
-            return true;
-        } else {
-#ifdef QT_DEBUG
-            qDebug() << "can't create table:" << table_name;
-            qDebug() << tr("error:") << query.lastError().text();
-            qDebug() << tr("last query:") << query.lastQuery();
-#endif
-            return false;
-        }
-    }
-
-    return false;
-}
-
-void db_writer_worker::update_last_error(QSqlQuery *query)
-{
-    if(query)
-    {
-        m_str_error_dbase = query->lastError().text();
-
-#ifdef QT_DEBUG
-        qDebug() << tr("error:") << m_str_error_dbase;
-        qDebug() << tr("last query:") << query->lastQuery();
-#endif
-
-    }
-}
-
 void db_writer_worker::data_spectr_to_write(const data_spectr &data)
 {
-    if(m_dbase.isOpen()&&(m_db_file_state.value(m_dbase.databaseName()) == state_db::file_is_ready))
+    if(ptr_storage->is_open()&&(m_db_file_state.value(ptr_storage->file_name()) == state_db::file_is_ready))
     {
-        QSqlQuery* query = new QSqlQuery(m_dbase);
-        query->prepare(insert_table_sql(spectr_data_table));
-
-        QByteArray ba(data.to_json());
-        query->bindValue(":params_id", data.id_params());
-        query->bindValue(":data_spectr", ba);
-
-        bool on = query->exec();
-
-        if(on)
+        if(ptr_storage->write_spectr(data))
         {
             //qDebug() << "id_params:" << data.id_params(); // << data.to_json();
-            update_size_file(m_dbase.databaseName());
+            update_size_file(ptr_storage->file_name());
         }
-
-        if(!on)
-            update_last_error(query);
     }
 
 
-    if(m_db_file_state.value(m_dbase.databaseName()) == state_db::file_is_full)
+    if(m_db_file_state.value(ptr_storage->file_name()) == state_db::file_is_full)
     {
-        qDebug() << "file is full:" << m_dbase.databaseName();
+        qDebug() << "file is full:" << ptr_storage->file_name();
 
         close_db();
 
@@ -281,39 +243,35 @@ void db_writer_worker::data_spectr_to_write(const data_spectr &data)
         if(!db_file.isEmpty())
         {            
             open_db(file_selection_for_writing());
+
+            if(ptr_storage->is_open())
+                emit signal_active_chunk(ptr_storage->file_name());
         } else {
-            qDebug() << "all files are full:" << m_dbase.databaseName();
+            qDebug() << "all files are full:" << ptr_storage->file_name();
         }
     }
 }
 
 void db_writer_worker::data_params_to_write(const params_spectr &data_params)
 {
-    if(m_dbase.isOpen()&&(m_db_file_state.value(m_dbase.databaseName()) == state_db::file_is_ready))
+    if(ptr_storage->is_open()&&(m_db_file_state.value(ptr_storage->file_name()) == state_db::file_is_ready))
     {
-        QSqlQuery* query = new QSqlQuery(m_dbase);
-        query->prepare(insert_table_sql(spectr_params_table));
-
-        QByteArray ba(data_params.to_json());
-        query->bindValue(":params_id", data_params.id_params());
-        query->bindValue(":data_params", ba);
-
-        bool on = query->exec();
-
-        if(on)
-            update_size_file(m_dbase.databaseName());
-
-        if(!on)
-            update_last_error(query);
+        if(ptr_storage->write_params(data_params))
+            update_size_file(ptr_storage->file_name());
     }
 }
 
 void db_writer_worker::update_size_file(const QString &db_name)
 {
     qint64 size = 0;
-    QFileInfo info(db_name);
 
-    size = info.size();
+    if(ptr_storage->is_open()&&(ptr_storage->file_name() == db_name))
+    {
+        size = ptr_storage->file_size();
+    }else{
+        QFileInfo info(db_name);
+        size = info.size();
+    }
 
     m_db_file_size.insert(db_name, size);
 
@@ -321,7 +279,7 @@ void db_writer_worker::update_size_file(const QString &db_name)
     {
         m_db_file_state.insert(db_name, state_db::file_is_full);
 
-        if(m_dbase.isOpen())
+        if(ptr_storage->is_open())
             close_db();
 
         emit signal_state_db(db_name, state_db::file_is_full);
@@ -334,62 +292,45 @@ void db_writer_worker::update_size_file(const QString &db_name)
     emit signal_file_size(db_name, size);
 }
 
-QString db_writer_worker::file_selection_for_writing() const
+QString db_writer_worker::file_selection_for_resume() const
 {
     const auto file_list = m_db_file_state.keys();
+    QString file_name;
+    QDateTime last_modified;
 
     for(int i=0; i<file_list.size(); ++i)
-        if(m_db_file_state.value(file_list.at(i)) != state_db::file_is_full)
-            return file_list.at(i);
-
-    return "";
-}
-
-void db_writer_worker::clean_file_db(const QString &file_name)
-{
-    QFileInfo file_db(file_name);
-
-    if(file_db.exists())
     {
-        open_db(file_name);
-
-        if(m_dbase.isOpen())
+        if(m_db_file_state.value(file_list.at(i)) != state_db::file_is_full)
         {
-            const auto list_table = table.keys();
-
-            QTimer start_time;
-            start_time.start();
-
-#ifdef QT_DEBUG
-            //qDebug() << "start clean database:" << start_time.toString();
-            qDebug() << "database:" << file_name;
-#endif
+            const QDateTime modified = QFileInfo(file_list.at(i)).lastModified();
 
-            for(int i=0; i<list_table.size(); ++i)
+            if(file_name.isEmpty()||(modified > last_modified))
             {
-                if(is_table_name_resolve(list_table.at(i)))
-                {
-#ifdef QT_DEBUG
-                    qDebug() << "delete from table:" << list_table.at(i);
-#endif
-                    QSqlQuery* query_delete = new QSqlQuery(m_dbase);
-                    if(!query_delete->exec(delete_table_sql(list_table.at(i))))
-                        update_last_error(query_delete);
-                }
+                file_name = file_list.at(i);
+                last_modified = modified;
             }
-
-            close_db();
-
-//#ifdef QT_DEBUG
-//            qDebug() << "stop clean database:" << start_time.currentTime().toString()
-//                     << QString("Time elapsed: %1 ms").arg(start_time.elapsed());
-//#endif
         }
     }
+
+    if(file_name.isEmpty())
+        file_name = file_selection_for_writing();
+
+    return file_name;
+}
+
+QString db_writer_worker::file_selection_for_writing() const
+{
+    const auto file_list = m_db_file_state.keys();
+
+    for(int i=0; i<file_list.size(); ++i)
+        if(m_db_file_state.value(file_list.at(i)) != state_db::file_is_full)
+            return file_list.at(i);
+
+    return "";
 }
 
 void db_writer_worker::close_db()
 {
-    if(m_dbase.isOpen())
-        m_dbase.close();
+    if(ptr_storage->is_open())
+        ptr_storage->close();
 }
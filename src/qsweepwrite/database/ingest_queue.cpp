@@ -0,0 +1,285 @@
+#include "ingest_queue.h"
+
+#include <QDir>
+#include <QDataStream>
+
+#ifdef QT_DEBUG
+#include <QtCore/qdebug.h>
+#endif
+
+// journal files (db_path), %1 - db writer index
+static const QString ingest_journal_name = "ingest_journal_%1.bin";
+static const QString ingest_replay_name = "ingest_journal_%1.replay";
+
+// max producer wait (overflow_policy::block), ms
+static const unsigned long ingest_block_timeout = 100;
+
+ingest_queue::ingest_queue()
+{
+    m_capacity = 1000;
+    m_policy = overflow_policy::drop_oldest;
+    m_notify_pending = false;
+    m_consumer_running = false;
+    m_journal_count = 0;
+}
+
+ingest_queue::~ingest_queue()
+{
+    if(m_journal_file.isOpen())
+        m_journal_file.close();
+
+    if(m_replay_file.isOpen())
+        m_replay_file.close();
+}
+
+void ingest_queue::set_configuration(const sweep_write_settings &settings, const int &index)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_capacity = qMax(1, settings.ingest_queue_size());
+    m_policy = settings.ingest_overflow_policy();
+
+    const QString path = settings.db_path().isEmpty() ? QString() : settings.db_path() + QDir::separator();
+    m_journal_name = path + ingest_journal_name.arg(index);
+    m_replay_name = path + ingest_replay_name.arg(index);
+
+    // journal left by the previous run
+    if(QFile::exists(m_replay_name))
+    {
+        m_replay_file.setFileName(m_replay_name);
+        m_replay_file.open(QIODevice::ReadOnly);
+    }
+
+    m_journal_count = count_journal();
+    m_notify_pending = m_replay_file.isOpen()||(m_journal_count > 0);
+}
+
+void ingest_queue::set_consumer_running(const bool &is_running)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_consumer_running = is_running;
+
+    // release a waiting producer
+    if(!is_running)
+        m_not_full.wakeAll();
+}
+
+bool ingest_queue::push(const QByteArray &data)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_stat.m_received++;
+
+    // journal is not drained yet: new data goes after it (time order),
+    // the memory queue holds only data older than the journal
+    if(is_journal_pending())
+    {
+        if(!spill(data))
+            m_stat.m_dropped++;
+    }else if(m_queue.size() >= m_capacity){
+        switch (m_policy) {
+        case overflow_policy::block:
+            // backpressure: producer waits briefly while the writer drains the queue,
+            // a stopped writer never frees space - spill at once
+            while(m_consumer_running&&(m_queue.size() >= m_capacity))
+                if(!m_not_full.wait(&m_mutex, ingest_block_timeout))
+                    break;
+
+            if(m_queue.size() >= m_capacity)
+            {
+                if(!spill(data))
+                    m_stat.m_dropped++;
+            }else{
+                m_queue.enqueue(data);
+            }
+            break;
+        case overflow_policy::drop_oldest:
+            m_queue.dequeue();
+            m_stat.m_dropped++;
+            m_queue.enqueue(data);
+            break;
+        case overflow_policy::spill:
+            if(!spill(data))
+                m_stat.m_dropped++;
+            break;
+        }
+    }else{
+        m_queue.enqueue(data);
+    }
+
+    m_stat.m_high_water = qMax(m_stat.m_high_water, static_cast<qint64>(m_queue.size()));
+
+    if(m_notify_pending)
+        return false;
+
+    m_notify_pending = true;
+
+    return true;
+}
+
+bool ingest_queue::take_batch(const int &max_count, QVector<QByteArray> &batch)
+{
+    bool is_replay(false);
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        while((batch.size() < max_count)&&(!m_queue.isEmpty()))
+            batch.append(m_queue.dequeue());
+
+        m_not_full.wakeAll();
+
+        // memory queue is empty: switch to the journal
+        if(batch.size() < max_count)
+        {
+            if((!m_replay_file.isOpen())&&(m_journal_count > 0))
+                start_replay();
+
+            is_replay = m_replay_file.isOpen();
+        }
+    }
+
+    // replay file belongs to the consumer only
+    if(is_replay)
+        read_replay(max_count, batch);
+
+    QMutexLocker locker(&m_mutex);
+
+    const bool is_more = (!m_queue.isEmpty())
+            || m_replay_file.isOpen()
+            || (m_journal_count > 0);
+
+    // next push must notify the consumer
+    if(!is_more)
+        m_notify_pending = false;
+
+    return is_more;
+}
+
+ingest_queue_stat ingest_queue::stat()
+{
+    QMutexLocker locker(&m_mutex);
+
+    ingest_queue_stat result(m_stat);
+    result.m_depth = m_queue.size();
+    result.m_journal = m_journal_count;
+
+    return result;
+}
+
+bool ingest_queue::is_journal_pending() const
+{
+    // called under lock: the replay file is opened and closed under lock only
+    return (m_journal_count > 0)||m_replay_file.isOpen();
+}
+
+qint64 ingest_queue::count_journal() const
+{
+    qint64 count = 0;
+    QFile file(m_journal_name);
+
+    if(file.open(QIODevice::ReadOnly))
+    {
+        QDataStream in(&file);
+
+        while(!file.atEnd())
+        {
+            quint32 size = 0;
+            in >> size;
+
+            // QByteArray: size, data (0xFFFFFFFF - null)
+            if(in.status() != QDataStream::Ok)
+                break;
+
+            if(size != 0xFFFFFFFF)
+                if((file.pos() + size > file.size())||(!file.seek(file.pos() + size)))
+                    break;
+
+            count++;
+        }
+
+        file.close();
+    }
+
+    return count;
+}
+
+bool ingest_queue::spill(const QByteArray &data)
+{
+    if(!m_journal_file.isOpen())
+    {
+        m_journal_file.setFileName(m_journal_name);
+
+        if(!m_journal_file.open(QIODevice::WriteOnly | QIODevice::Append))
+        {
+#ifdef QT_DEBUG
+            qCritical() << "Can't open ingest journal:" << m_journal_name << m_journal_file.errorString();
+#endif
+            return false;
+        }
+    }
+
+    QDataStream out(&m_journal_file);
+    out << data;
+
+    if(out.status() != QDataStream::Ok)
+        return false;
+
+    m_journal_count++;
+    m_stat.m_spilled++;
+
+    return true;
+}
+
+void ingest_queue::start_replay()
+{
+    // called under lock: producer starts a new journal on the next spill
+    if(m_journal_file.isOpen())
+        m_journal_file.close();
+
+    QFile::remove(m_replay_name);
+
+    if(QFile::rename(m_journal_name, m_replay_name))
+    {
+        m_replay_file.setFileName(m_replay_name);
+        m_replay_file.open(QIODevice::ReadOnly);
+    }
+
+    if(!m_replay_file.isOpen())
+        m_stat.m_dropped += m_journal_count;
+
+    m_journal_count = 0;
+}
+
+int ingest_queue::read_replay(const int &max_count, QVector<QByteArray> &batch)
+{
+    QDataStream in(&m_replay_file);
+    int count = 0;
+
+    while((batch.size() < max_count)&&(!m_replay_file.atEnd()))
+    {
+        QByteArray data;
+        in >> data;
+
+        if(in.status() != QDataStream::Ok)
+            break;
+
+        batch.append(data);
+        count++;
+    }
+
+    const bool is_done = m_replay_file.atEnd() || (in.status() != QDataStream::Ok);
+
+    QMutexLocker locker(&m_mutex);
+
+    m_stat.m_replayed += count;
+
+    if(is_done)
+    {
+        m_replay_file.close();
+        QFile::remove(m_replay_name);
+    }
+
+    return count;
+}
@@ -0,0 +1,67 @@
+#ifndef INGEST_QUEUE_H
+#define INGEST_QUEUE_H
+
+#include <QByteArray>
+#include <QQueue>
+#include <QVector>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFile>
+
+#include "sweep_write_settings.h"
+
+struct ingest_queue_stat
+{
+    qint64 m_depth = 0;         // messages in memory
+    qint64 m_high_water = 0;    // max depth
+    qint64 m_received = 0;
+    qint64 m_dropped = 0;
+    qint64 m_spilled = 0;       // written to journal
+    qint64 m_replayed = 0;      // read back from journal
+    qint64 m_journal = 0;       // messages waiting in journal
+};
+
+// bounded queue between mqtt provider (producer) and db writer (consumer)
+class ingest_queue
+{
+public:
+    ingest_queue();
+    ~ingest_queue();
+
+    void set_configuration(const sweep_write_settings &, const int &index = 0);
+    // false - the producer never waits (overflow_policy::block)
+    void set_consumer_running(const bool &);
+
+    // true - consumer must be notified
+    bool push(const QByteArray &);
+    // true - queue (or journal) has more data
+    bool take_batch(const int &max_count, QVector<QByteArray> &batch);
+
+    ingest_queue_stat stat();
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_not_full;
+    QQueue<QByteArray> m_queue;
+
+    int m_capacity;
+    overflow_policy m_policy;
+    bool m_notify_pending;
+    bool m_consumer_running;
+    ingest_queue_stat m_stat;
+
+    // spill: producer appends to journal, consumer replays it
+    QString m_journal_name;
+    QString m_replay_name;
+    QFile m_journal_file;
+    QFile m_replay_file;
+    qint64 m_journal_count;
+
+    qint64 count_journal()const;
+    bool is_journal_pending()const;
+    bool spill(const QByteArray &);
+    void start_replay();
+    int read_replay(const int &max_count, QVector<QByteArray> &batch);
+};
+
+#endif // INGEST_QUEUE_H
@@ -0,0 +1,146 @@
+#include "spectr_log_reader.h"
+
+#include <algorithm>
+#include <cstring>
+
+spectr_log_reader::spectr_log_reader()
+{
+    m_data_end = 0;
+}
+
+spectr_log_reader::~spectr_log_reader()
+{
+    close();
+}
+
+bool spectr_log_reader::open(const QString &file_name)
+{
+    close();
+
+    m_file.setFileName(file_name);
+
+    if(!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = m_file.size();
+
+    if(size >= static_cast<qint64>(sizeof(log_segment_header)))
+        ptr_data = m_file.map(0, size);
+
+    if(ptr_data)
+    {
+        log_segment_header header;
+        std::memcpy(&header, ptr_data, sizeof(header));
+
+        if((std::memcmp(header.m_magic, log_segment_magic, sizeof(header.m_magic)) == 0)
+                &&(header.m_version == log_segment_version))
+        {
+            m_data_end = size;
+
+            // closed segment has an index, otherwise records are scanned to the end
+            if(size >= static_cast<qint64>(sizeof(header) + sizeof(log_segment_footer)))
+            {
+                log_segment_footer footer;
+                std::memcpy(&footer, ptr_data + size - sizeof(footer), sizeof(footer));
+
+                if((std::memcmp(footer.m_magic, log_index_magic, sizeof(footer.m_magic)) == 0)
+                        &&(static_cast<qint64>(footer.m_index_offset + footer.m_index_count*sizeof(log_index_entry) + sizeof(footer)) == size))
+                {
+                    m_data_end = static_cast<qint64>(footer.m_index_offset);
+                    m_index.resize(static_cast<int>(footer.m_index_count));
+
+                    if(!m_index.isEmpty())
+                        std::memcpy(m_index.data(), ptr_data + footer.m_index_offset,
+                                    m_index.size()*sizeof(log_index_entry));
+                }
+            }
+
+            return true;
+        }
+    }
+
+    close();
+
+    return false;
+}
+
+void spectr_log_reader::close()
+{
+    if(ptr_data)
+        m_file.unmap(const_cast<uchar*>(ptr_data));
+
+    if(m_file.isOpen())
+        m_file.close();
+
+    ptr_data = Q_NULLPTR;
+    m_index.clear();
+    m_data_end = 0;
+}
+
+bool spectr_log_reader::is_open() const
+{
+    return ptr_data != Q_NULLPTR;
+}
+
+qint64 spectr_log_reader::seek(const qint64 &time)
+{
+    qint64 offset = begin();
+
+    if(!m_index.isEmpty())
+    {
+        // last index entry before "time"
+        auto it = std::lower_bound(m_index.constBegin(), m_index.constEnd(), time,
+                                   [](const log_index_entry &entry, const qint64 &value) {
+            return entry.m_time < value;
+        });
+
+        if(it != m_index.constBegin())
+            --it;
+
+        offset = static_cast<qint64>(it->m_offset);
+    }
+
+    qint64 pos = offset;
+    log_record_view record;
+
+    while(next(pos, record))
+    {
+        if((record.m_header.m_type == log_record_spectr)&&(record.m_header.m_time >= time))
+            return offset;
+
+        offset = pos;
+    }
+
+    return end();
+}
+
+qint64 spectr_log_reader::begin() const
+{
+    return sizeof(log_segment_header);
+}
+
+qint64 spectr_log_reader::end() const
+{
+    return m_data_end;
+}
+
+bool spectr_log_reader::next(qint64 &offset, log_record_view &record) const
+{
+    if((!ptr_data)||(offset + static_cast<qint64>(sizeof(log_record_header)) > m_data_end))
+        return false;
+
+    std::memcpy(&record.m_header, ptr_data + offset, sizeof(log_record_header));
+
+    const qint64 payload_offset = offset + static_cast<qint64>(sizeof(log_record_header));
+
+    if(payload_offset + record.m_header.m_payload_size > m_data_end)
+        return false;
+
+    record.m_payload = reinterpret_cast<const char*>(ptr_data + payload_offset);
+    record.m_power = (record.m_header.m_type == log_record_spectr)
+            ? reinterpret_cast<const float*>(ptr_data + payload_offset) : Q_NULLPTR;
+
+    offset = payload_offset + record.m_header.m_payload_size;
+
+    return true;
+}
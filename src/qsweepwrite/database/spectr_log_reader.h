@@ -0,0 +1,44 @@
+#ifndef SPECTR_LOG_READER_H
+#define SPECTR_LOG_READER_H
+
+#include <QFile>
+#include <QVector>
+
+#include "spectr_log_storage.h"
+
+// record in the mapped segment (valid while the reader is open)
+struct log_record_view
+{
+    log_record_header m_header;
+    const float *m_power {Q_NULLPTR};     // log_record_spectr
+    const char *m_payload {Q_NULLPTR};
+};
+
+// read only access to a closed segment through a memory map
+class spectr_log_reader
+{
+public:
+    spectr_log_reader();
+    ~spectr_log_reader();
+
+    bool open(const QString &);
+    void close();
+    bool is_open()const;
+
+    // first record with time >= value (or end), uses the sparse index
+    qint64 seek(const qint64 &time);
+    qint64 begin()const;
+    qint64 end()const;
+
+    // read record at offset, offset moves to the next record
+    bool next(qint64 &offset, log_record_view &record)const;
+
+private:
+    QFile m_file;
+    const uchar *ptr_data {Q_NULLPTR};
+    qint64 m_data_end;
+    // copy of the index: entries in the map are only 4-byte aligned
+    QVector<log_index_entry> m_index;
+};
+
+#endif // SPECTR_LOG_READER_H
@@ -0,0 +1,305 @@
+#include "spectr_log_storage.h"
+
+#include <QFileInfo>
+#include <cstring>
+
+#include "data_spectr.h"
+#include "params_spectr.h"
+
+#ifdef QT_DEBUG
+#include <QtCore/qdebug.h>
+#endif
+
+static log_segment_header make_segment_header()
+{
+    log_segment_header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.m_magic, log_segment_magic, sizeof(header.m_magic));
+    header.m_version = log_segment_version;
+    header.m_header_size = sizeof(log_segment_header);
+    header.m_index_interval = log_index_interval;
+
+    return header;
+}
+
+static quint32 padded_size(const qint64 &size)
+{
+    return static_cast<quint32>((size + 3) & ~static_cast<qint64>(3));
+}
+
+spectr_log_storage::spectr_log_storage()
+{
+    m_size = 0;
+    m_spectr_count = 0;
+}
+
+spectr_log_storage::~spectr_log_storage()
+{
+    close();
+}
+
+bool spectr_log_storage::open(const QString &file_name)
+{
+    close();
+
+    m_index.clear();
+    m_spectr_count = 0;
+    m_size = 0;
+
+    m_file.setFileName(file_name);
+
+    if(!m_file.open(QIODevice::ReadWrite))
+    {
+        m_str_error = m_file.errorString();
+#ifdef QT_DEBUG
+        qDebug() << "Can't open spectr log:" << file_name;
+        qDebug() << "Error:" << m_str_error;
+#endif
+        return false;
+    }
+
+    bool is_open(false);
+
+    if(m_file.size() == 0)
+    {
+        const log_segment_header header = make_segment_header();
+        is_open = (m_file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header));
+        m_size = sizeof(header);
+    }else{
+        is_open = restore_segment();
+    }
+
+    if(!is_open)
+    {
+        m_str_error = QString("Invalid spectr log segment: %1").arg(file_name);
+#ifdef QT_DEBUG
+        qDebug() << m_str_error;
+#endif
+        m_file.close();
+    }
+
+    return is_open;
+}
+
+void spectr_log_storage::close()
+{
+    if(!m_file.isOpen())
+        return;
+
+    // sparse time index and footer
+    log_segment_footer footer;
+    std::memset(&footer, 0, sizeof(footer));
+    footer.m_index_offset = static_cast<quint64>(m_size);
+    footer.m_index_count = static_cast<quint32>(m_index.size());
+    footer.m_spectr_count = m_spectr_count;
+    std::memcpy(footer.m_magic, log_index_magic, sizeof(footer.m_magic));
+    footer.m_version = log_segment_version;
+
+    m_file.seek(m_size);
+
+    if(!m_index.isEmpty())
+        m_file.write(reinterpret_cast<const char*>(m_index.constData()),
+                     m_index.size()*static_cast<qint64>(sizeof(log_index_entry)));
+
+    m_file.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    m_file.close();
+}
+
+bool spectr_log_storage::is_open() const
+{
+    return m_file.isOpen();
+}
+
+QString spectr_log_storage::file_name() const
+{
+    return m_file.fileName();
+}
+
+qint64 spectr_log_storage::file_size() const
+{
+    // QFile::size() flushes the write buffer
+    if(m_file.isOpen())
+        return m_size;
+
+    QFileInfo info(m_file.fileName());
+
+    return info.size();
+}
+
+bool spectr_log_storage::write_spectr(const data_spectr &data)
+{
+    if(!m_file.isOpen())
+        return false;
+
+    const QByteArray params_id = data.id_params().toLatin1();
+    const QVector<power_spectr> powers = data.spectr();
+    QVector<float> payload;
+    bool on(true);
+
+    for(int i=0; (i<powers.size())&&on; ++i)
+    {
+        const power_spectr &power = powers.at(i);
+
+        log_record_header header;
+        std::memset(&header, 0, sizeof(header));
+        header.m_type = log_record_spectr;
+        header.m_time = power.m_date_time.toMSecsSinceEpoch();
+        header.m_hz_low = power.hz_low;
+        header.m_hz_high = power.hz_high;
+        header.m_fft_bin_width = power.m_fft_bin_width;
+        header.m_num_samples = power.num_samples;
+        header.m_bin_count = static_cast<quint32>(power.m_power.size());
+        header.m_payload_size = header.m_bin_count*sizeof(float);
+        std::memcpy(header.m_params_id, params_id.constData(),
+                    static_cast<size_t>(qMin(params_id.size(), static_cast<int>(sizeof(header.m_params_id)))));
+
+        payload.resize(power.m_power.size());
+
+        for(int w=0; w<power.m_power.size(); ++w)
+            payload[w] = static_cast<float>(power.m_power.at(w));
+
+        if(m_spectr_count%log_index_interval == 0)
+            m_index.append({header.m_time, static_cast<quint64>(m_size)});
+
+        on = write_record(header, reinterpret_cast<const char*>(payload.constData()), header.m_payload_size);
+
+        if(on)
+            m_spectr_count++;
+    }
+
+    return on;
+}
+
+bool spectr_log_storage::write_params(const params_spectr &data_params)
+{
+    if(!m_file.isOpen())
+        return false;
+
+    const QByteArray params_id = data_params.id_params().toLatin1();
+    QByteArray payload(data_params.to_json());
+
+    log_record_header header;
+    std::memset(&header, 0, sizeof(header));
+    header.m_type = log_record_params;
+    header.m_time = QDateTime::currentDateTimeUtc().toMSecsSinceEpoch();
+    header.m_payload_size = padded_size(payload.size());
+    std::memcpy(header.m_params_id, params_id.constData(),
+                static_cast<size_t>(qMin(params_id.size(), static_cast<int>(sizeof(header.m_params_id)))));
+
+    payload.append(QByteArray(static_cast<int>(header.m_payload_size) - payload.size(), '\0'));
+
+    return write_record(header, payload.constData(), header.m_payload_size);
+}
+
+bool spectr_log_storage::create_empty(const QString &file_name)
+{
+    QFile file(file_name);
+
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    const log_segment_header header = make_segment_header();
+    const bool is_created = (file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header));
+
+    file.close();
+
+    return is_created;
+}
+
+bool spectr_log_storage::restore_segment()
+{
+    const qint64 size = m_file.size();
+
+    log_segment_header header;
+
+    if((size < static_cast<qint64>(sizeof(header)))
+            ||(m_file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)))
+        return false;
+
+    if((std::memcmp(header.m_magic, log_segment_magic, sizeof(header.m_magic)) != 0)
+            ||(header.m_version != log_segment_version)
+            ||(header.m_header_size != sizeof(log_segment_header)))
+        return false;
+
+    qint64 data_end = -1;
+
+    // closed segment: load index, drop index and footer (appended again on close)
+    if(size >= static_cast<qint64>(sizeof(header) + sizeof(log_segment_footer)))
+    {
+        log_segment_footer footer;
+        m_file.seek(size - static_cast<qint64>(sizeof(footer)));
+
+        if((m_file.read(reinterpret_cast<char*>(&footer), sizeof(footer)) == sizeof(footer))
+                &&(std::memcmp(footer.m_magic, log_index_magic, sizeof(footer.m_magic)) == 0)
+                &&(static_cast<qint64>(footer.m_index_offset + footer.m_index_count*sizeof(log_index_entry) + sizeof(footer)) == size))
+        {
+            m_index.resize(static_cast<int>(footer.m_index_count));
+            m_file.seek(static_cast<qint64>(footer.m_index_offset));
+
+            const qint64 index_size = m_index.size()*static_cast<qint64>(sizeof(log_index_entry));
+
+            if(m_file.read(reinterpret_cast<char*>(m_index.data()), index_size) == index_size)
+            {
+                data_end = static_cast<qint64>(footer.m_index_offset);
+                m_spectr_count = footer.m_spectr_count;
+            }else{
+                m_index.clear();
+            }
+        }
+    }
+
+    // not closed (crash): rebuild index, drop incomplete record
+    if(data_end < 0)
+    {
+        qint64 pos = sizeof(log_segment_header);
+        log_record_header record;
+
+        while(pos + static_cast<qint64>(sizeof(record)) <= size)
+        {
+            m_file.seek(pos);
+
+            if(m_file.read(reinterpret_cast<char*>(&record), sizeof(record)) != sizeof(record))
+                break;
+
+            if(((record.m_type != log_record_spectr)&&(record.m_type != log_record_params))
+                    ||(pos + static_cast<qint64>(sizeof(record)) + record.m_payload_size > size))
+                break;
+
+            if(record.m_type == log_record_spectr)
+            {
+                if(m_spectr_count%log_index_interval == 0)
+                    m_index.append({record.m_time, static_cast<quint64>(pos)});
+
+                m_spectr_count++;
+            }
+
+            pos += static_cast<qint64>(sizeof(record)) + record.m_payload_size;
+        }
+
+        data_end = pos;
+    }
+
+    if(!m_file.resize(data_end))
+        return false;
+
+    m_size = data_end;
+
+    return m_file.seek(m_size);
+}
+
+bool spectr_log_storage::write_record(const log_record_header &header, const char *payload, const qint64 &payload_size)
+{
+    const qint64 header_size = sizeof(header);
+
+    bool on = (m_file.write(reinterpret_cast<const char*>(&header), header_size) == header_size);
+
+    if(on&&(payload_size > 0))
+        on = (m_file.write(payload, payload_size) == payload_size);
+
+    if(on)
+        m_size += header_size + payload_size;
+    else
+        m_str_error = m_file.errorString();
+
+    return on;
+}
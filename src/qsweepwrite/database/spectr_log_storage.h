@@ -0,0 +1,98 @@
+#ifndef SPECTR_LOG_STORAGE_H
+#define SPECTR_LOG_STORAGE_H
+
+#include <QFile>
+#include <QVector>
+
+#include "storage_backend.h"
+
+// Segment file (one chunk) of the spectrum log, host byte order:
+//   log_segment_header
+//   records: log_record_header + payload (float32 powers or params json),
+//            payload is padded to 4 bytes
+//   sparse time index: log_index_entry[index_count] (written on close)
+//   log_segment_footer
+
+static const char log_segment_magic[4] = {'Q', 'S', 'W', 'L'};
+static const char log_index_magic[4] = {'Q', 'S', 'W', 'I'};
+static const quint32 log_segment_version = 1;
+// index entry per N spectr records
+static const quint32 log_index_interval = 256;
+
+enum log_record_type: quint32 {
+    log_record_spectr = 1,
+    log_record_params = 2
+};
+
+struct log_segment_header
+{
+    char m_magic[4];
+    quint32 m_version;
+    quint32 m_header_size;
+    quint32 m_index_interval;
+    quint64 m_reserved[2];
+};
+
+struct log_record_header
+{
+    quint32 m_type;
+    quint32 m_payload_size;     // bytes, padded
+    qint64 m_time;              // ms since epoch (UTC)
+    quint64 m_hz_low;
+    quint64 m_hz_high;
+    double m_fft_bin_width;
+    quint32 m_num_samples;
+    quint32 m_bin_count;        // float32 values in payload (spectr)
+    char m_params_id[8];
+};
+
+struct log_index_entry
+{
+    qint64 m_time;
+    quint64 m_offset;
+};
+
+struct log_segment_footer
+{
+    quint64 m_index_offset;
+    quint32 m_index_count;
+    quint32 m_spectr_count;     // spectr records in the segment
+    char m_magic[4];
+    quint32 m_version;
+};
+
+static_assert(sizeof(log_segment_header) == 32, "log_segment_header size");
+static_assert(sizeof(log_record_header) == 56, "log_record_header size");
+static_assert(sizeof(log_index_entry) == 16, "log_index_entry size");
+static_assert(sizeof(log_segment_footer) == 24, "log_segment_footer size");
+
+class spectr_log_storage : public storage_backend
+{
+public:
+    spectr_log_storage();
+    ~spectr_log_storage() Q_DECL_OVERRIDE;
+
+    bool open(const QString &) Q_DECL_OVERRIDE;
+    void close() Q_DECL_OVERRIDE;
+    bool is_open()const Q_DECL_OVERRIDE;
+
+    QString file_name()const Q_DECL_OVERRIDE;
+    qint64 file_size()const Q_DECL_OVERRIDE;
+
+    bool write_spectr(const data_spectr &) Q_DECL_OVERRIDE;
+    bool write_params(const params_spectr &) Q_DECL_OVERRIDE;
+
+    // empty segment (header only)
+    static bool create_empty(const QString &);
+
+private:
+    QFile m_file;
+    qint64 m_size;
+    quint32 m_spectr_count;
+    QVector<log_index_entry> m_index;
+
+    bool restore_segment();
+    bool write_record(const log_record_header &, const char *payload, const qint64 &payload_size);
+};
+
+#endif // SPECTR_LOG_STORAGE_H
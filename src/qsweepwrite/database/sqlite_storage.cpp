@@ -0,0 +1,183 @@
+#include "sqlite_storage.h"
+#include "db_const.h"
+
+#include <QSqlError>
+#include <QFileInfo>
+
+#include "data_spectr.h"
+#include "params_spectr.h"
+
+#ifdef QT_DEBUG
+#include <QtCore/qdebug.h>
+#endif
+
+sqlite_storage::sqlite_storage(const QString &connection_name)
+{
+    m_dbase = QSqlDatabase::addDatabase(database_driver, connection_name);
+}
+
+sqlite_storage::~sqlite_storage()
+{
+    close();
+}
+
+bool sqlite_storage::open(const QString &db_name)
+{
+    m_dbase.setDatabaseName(db_name);
+
+    if(m_dbase.open())
+    {
+        //PRAGMA page_size = bytes; // размер страницы БД; страница БД - это единица обмена между диском и кэшом, разумно сделать равным размеру кластера диска (у меня 4096)
+        //PRAGMA cache_size = -kibibytes; // задать размер кэша соединения в килобайтах, по умолчанию он равен 2000 страниц БД
+        //PRAGMA encoding = "UTF-8";  // тип данных БД, всегда используйте UTF-8
+        //PRAGMA foreign_keys = 1; // включить поддержку foreign keys, по умолчанию - ОТКЛЮЧЕНА
+        //PRAGMA journal_mode = DELETE | TRUNCATE | PERSIST | MEMORY | WAL | OFF;  // задать тип журнала, см. далее
+        //PRAGMA synchronous = 0 | OFF | 1 | NORMAL | 2 | FULL; // тип синхронизации транзакции, см. далее
+        //PRAGMA schema.auto_vacuum = 0 | NONE | 1 | FULL | 2 | INCREMENTAL;
+
+        set_pragma("synchronous", "0");
+        set_pragma("auto_vacuum", "1");
+
+        const auto list_table = table.keys();
+
+        for(int i=0; i<list_table.size(); i++)
+            if(!is_table_name_resolve(list_table.at(i)))
+                create_table(list_table.at(i));
+
+        ptr_insert_spectr.reset(new spectr_data_insert(m_dbase));
+        ptr_insert_params.reset(new spectr_params_insert(m_dbase));
+
+        if(!ptr_insert_spectr->is_prepared())
+            update_last_error(ptr_insert_spectr->query());
+
+        if(!ptr_insert_params->is_prepared())
+            update_last_error(ptr_insert_params->query());
+
+    }else{
+        m_str_error = m_dbase.lastError().text();
+#ifdef QT_DEBUG
+        qDebug() << "Can't database open:" << db_name;
+        qDebug() << "Error:" << m_dbase.lastError();
+#endif
+    }
+
+    return m_dbase.isOpen();
+}
+
+void sqlite_storage::close()
+{
+    ptr_insert_spectr.reset();
+    ptr_insert_params.reset();
+    m_schema_cache.clear();
+
+    if(m_dbase.isOpen())
+        m_dbase.close();
+}
+
+bool sqlite_storage::is_open() const
+{
+    return m_dbase.isOpen();
+}
+
+QString sqlite_storage::file_name() const
+{
+    return m_dbase.databaseName();
+}
+
+qint64 sqlite_storage::file_size() const
+{
+    QFileInfo info(m_dbase.databaseName());
+
+    return info.size();
+}
+
+bool sqlite_storage::write_spectr(const data_spectr &data)
+{
+    bool on(false);
+
+    if(m_dbase.isOpen()&&ptr_insert_spectr)
+    {
+        on = ptr_insert_spectr->exec(data.id_params(), data.to_json());
+
+        if(!on)
+            update_last_error(ptr_insert_spectr->query());
+    }
+
+    return on;
+}
+
+bool sqlite_storage::write_params(const params_spectr &data_params)
+{
+    bool on(false);
+
+    if(m_dbase.isOpen()&&ptr_insert_params)
+    {
+        on = ptr_insert_params->exec(data_params.id_params(), data_params.to_json());
+
+        if(!on)
+            update_last_error(ptr_insert_params->query());
+    }
+
+    return on;
+}
+
+void sqlite_storage::set_pragma(const QString &param, const QString &value)
+{
+    QString sql_query(pragma_sql(param, value));
+
+    if (m_dbase.isOpen())
+    {
+        QSqlQuery query(m_dbase);
+
+        if(!query.exec(sql_query))
+            update_last_error(&query);
+    }
+}
+
+bool sqlite_storage::is_table_name_resolve(const QString &table_name)
+{
+    if(m_dbase.isOpen()&&(!table_name.isEmpty()))
+        return m_schema_cache.contains(m_dbase, table_name);
+
+    return false;
+}
+
+bool sqlite_storage::create_table(const QString &table_name)
+{
+    if(m_dbase.isOpen()&&(!table_name.isEmpty()))
+    {
+        QSqlQuery query(m_dbase);
+        QString sql = create_table_sql(table_name);
+
+        if(query.exec(sql)){
+            m_schema_cache.insert(table_name);
+#ifdef QT_DEBUG
+            qDebug() << "create table:" << table_name;
+#endif
+            return true;
+        } else {
+#ifdef QT_DEBUG
+            qDebug() << "can't create table:" << table_name;
+            qDebug() << "error:" << query.lastError().text();
+            qDebug() << "last query:" << query.lastQuery();
+#endif
+            return false;
+        }
+    }
+
+    return false;
+}
+
+void sqlite_storage::update_last_error(QSqlQuery *query)
+{
+    if(query)
+    {
+        m_str_error = query->lastError().text();
+
+#ifdef QT_DEBUG
+        qDebug() << "error:" << m_str_error;
+        qDebug() << "last query:" << query->lastQuery();
+#endif
+
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef SQLITE_STORAGE_H
+#define SQLITE_STORAGE_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QScopedPointer>
+
+#include "storage_backend.h"
+#include "db_statement.h"
+
+class sqlite_storage : public storage_backend
+{
+public:
+    explicit sqlite_storage(const QString &connection_name);
+    ~sqlite_storage() Q_DECL_OVERRIDE;
+
+    bool open(const QString &) Q_DECL_OVERRIDE;
+    void close() Q_DECL_OVERRIDE;
+    bool is_open()const Q_DECL_OVERRIDE;
+
+    QString file_name()const Q_DECL_OVERRIDE;
+    qint64 file_size()const Q_DECL_OVERRIDE;
+
+    bool write_spectr(const data_spectr &) Q_DECL_OVERRIDE;
+    bool write_params(const params_spectr &) Q_DECL_OVERRIDE;
+
+private:
+    QSqlDatabase m_dbase;
+    schema_cache m_schema_cache;
+    // prepared on open, released before close
+    QScopedPointer<spectr_data_insert> ptr_insert_spectr;
+    QScopedPointer<spectr_params_insert> ptr_insert_params;
+
+    void set_pragma(const QString &, const QString &);
+    bool is_table_name_resolve(const QString &);
+    bool create_table(const QString &);
+    void update_last_error(QSqlQuery* query);
+};
+
+#endif // SQLITE_STORAGE_H
@@ -0,0 +1,66 @@
+#include "storage_backend.h"
+#include "sqlite_storage.h"
+#include "spectr_log_storage.h"
+#include "spectr_log_reader.h"
+#include "db_const.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QThread>
+
+storage_backend *create_storage_backend(const storage_type &type, const QString &connection_name)
+{
+    switch (type) {
+    case storage_type::spectr_log:
+        return new spectr_log_storage;
+    case storage_type::sqlite:
+        break;
+    }
+
+    return new sqlite_storage(connection_name);
+}
+
+static bool check_sqlite_file(const QString &file_name)
+{
+    bool is_ok(false);
+
+    // connection name is unique per thread and file
+    const QString connection_name = QString("%1_%2_%3").arg(connection_system)
+            .arg(reinterpret_cast<quintptr>(QThread::currentThreadId())).arg(qHash(file_name));
+
+    {
+        QSqlDatabase dbase = QSqlDatabase::addDatabase(database_driver, connection_name);
+        dbase.setDatabaseName(file_name);
+
+        if(dbase.open())
+        {
+            QSqlQuery query(dbase);
+
+            if(query.exec("PRAGMA quick_check")&&query.next())
+                is_ok = (query.value(0).toString() == "ok");
+
+            query.finish();
+            dbase.close();
+        }
+    }
+
+    QSqlDatabase::removeDatabase(connection_name);
+
+    return is_ok;
+}
+
+bool check_chunk_file(const storage_type &type, const QString &file_name)
+{
+    switch (type) {
+    case storage_type::spectr_log:
+    {
+        // header is valid, records are checked when the segment is opened
+        spectr_log_reader reader;
+        return reader.open(file_name);
+    }
+    case storage_type::sqlite:
+        break;
+    }
+
+    return check_sqlite_file(file_name);
+}
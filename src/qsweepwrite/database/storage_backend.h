@@ -0,0 +1,37 @@
+#ifndef STORAGE_BACKEND_H
+#define STORAGE_BACKEND_H
+
+#include <QString>
+
+#include "sweep_write_settings.h"
+
+class data_spectr;
+class params_spectr;
+
+// chunk storage used by db writer (one chunk file is open at a time)
+class storage_backend
+{
+public:
+    virtual ~storage_backend() {}
+
+    virtual bool open(const QString &) = 0;
+    virtual void close() = 0;
+    virtual bool is_open()const = 0;
+
+    virtual QString file_name()const = 0;
+    virtual qint64 file_size()const = 0;
+
+    virtual bool write_spectr(const data_spectr &) = 0;
+    virtual bool write_params(const params_spectr &) = 0;
+
+    QString last_error()const { return m_str_error; }
+
+protected:
+    QString m_str_error;
+};
+
+storage_backend *create_storage_backend(const storage_type &type, const QString &connection_name);
+// integrity check of an existing chunk (thread safe, own connection)
+bool check_chunk_file(const storage_type &type, const QString &file_name);
+
+#endif // STORAGE_BACKEND_H
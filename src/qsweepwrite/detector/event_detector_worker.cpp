@@ -0,0 +1,60 @@
+#include "event_detector_worker.h"
+
+#include "sweep_message.h"
+#include "spectr_frame.h"
+
+#ifdef QT_DEBUG
+#include <QtCore/qdebug.h>
+#endif
+
+event_detector_worker::event_detector_worker(QObject *parent) : QObject(parent)
+{
+    setObjectName(this->metaObject()->className());
+}
+
+void event_detector_worker::set_configuration(const sweep_write_settings &settings)
+{
+    m_settings = settings;
+
+    m_detector.set_threshold(static_cast<float>(m_settings.event_threshold()));
+    m_detector.set_min_bins(m_settings.event_min_bins());
+    m_detector.set_hold(m_settings.event_hold());
+}
+
+void event_detector_worker::slot_initialization()
+{
+    emit signal_update_state_workers(state_workers::initialization);
+}
+
+void event_detector_worker::slot_launching()
+{
+    emit signal_update_state_workers(state_workers::launching);
+}
+
+void event_detector_worker::slot_stopping()
+{
+    publish(m_detector.flush());
+
+    emit signal_update_state_workers(state_workers::stopping);
+}
+
+void event_detector_worker::slot_data_spectr(const data_spectr &data)
+{
+    publish(m_detector.process(spectr_frame::from_data_spectr(data)));
+}
+
+void event_detector_worker::publish(const QVector<spectr_event> &events)
+{
+    for(int i=0; i<events.size(); ++i)
+    {
+        sweep_message send_data;
+        send_data.set_type(type_message::data_event);
+        send_data.set_data_message(events.at(i).to_json());
+
+#ifdef QT_DEBUG
+        qDebug().noquote() << "event" << events.at(i).to_json();
+#endif
+
+        emit signal_publish_event(send_data.to_json());
+    }
+}
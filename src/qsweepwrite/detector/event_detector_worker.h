@@ -0,0 +1,38 @@
+#ifndef EVENT_DETECTOR_WORKER_H
+#define EVENT_DETECTOR_WORKER_H
+
+#include <QObject>
+
+#include "sweep_write_settings.h"
+#include "database/db_state_workers.h"
+#include "event_detector.h"
+#include "data_spectr.h"
+
+class event_detector_worker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit event_detector_worker(QObject *parent = nullptr);
+
+    void set_configuration(const sweep_write_settings &);
+
+public slots:
+    void slot_initialization();
+    void slot_launching();
+    void slot_stopping();
+
+    void slot_data_spectr(const data_spectr &);
+
+signals:
+    void signal_update_state_workers(const state_workers &type);
+    // event (sweep_message json)
+    void signal_publish_event(const QByteArray &);
+
+private:
+    sweep_write_settings m_settings;
+    event_detector m_detector;
+
+    void publish(const QVector<spectr_event> &);
+};
+
+#endif // EVENT_DETECTOR_WORKER_H
@@ -2,18 +2,21 @@
 
 #include <QDir>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QSqlQuery>
+#include <QSqlError>
 
-#include "database/db_const.h"
-
-#ifdef QT_DEBUG
 #include <QtCore/qdebug.h>
-#endif
+
+#include "database/db_const.h"
 
 file_backup_workers::file_backup_workers(QObject *parent) : QObject(parent)
 {
     setObjectName(this->metaObject()->className());
 
     is_ready = false;
+
+    m_dbase = QSqlDatabase::addDatabase(database_driver, connection_backup);
 }
 
 void file_backup_workers::set_configuration(const sweep_write_settings &settings)
@@ -58,6 +61,7 @@ void file_backup_workers::slot_file_backup(const QString &file_name)
     {
         QFileInfo in_file_info(file_name);
         QString file_name_gen = QDateTime::currentDateTimeUtc().toString("ddMMyyyy_hhmmss");
+        QFileInfo snapshot_file_info(m_settings.backup_path()+QDir::separator()+file_name_gen+snapshot_database_suffix);
         file_name_gen.append(".backup");
         QFileInfo out_file_info(m_settings.backup_path()+QDir::separator()+file_name_gen);
 
@@ -67,12 +71,77 @@ void file_backup_workers::slot_file_backup(const QString &file_name)
             qDebug() << "Input file name:" << in_file_info.filePath();
             qDebug() << "Output file name:" << out_file_info.filePath();
 #endif
-            file_compress(in_file_info.filePath(), out_file_info.filePath(), m_settings.backup_compress_level());
-
-            if(out_file_info.exists())
+            // compress a consistent (and compacted) copy of the chunk,
+            // the raw file is used only when snapshot is not possible
+            // (spectr log segment is closed by the writer before backup)
+            const bool is_snapshot = (m_settings.storage() == storage_type::sqlite)
+                    && snapshot_db(in_file_info.filePath(), snapshot_file_info.filePath());
+            const QString compress_file = is_snapshot ? snapshot_file_info.filePath() : in_file_info.filePath();
+
+            compress_stat stat;
+            const bool is_compressed = file_compress(compress_file, out_file_info.filePath(),
+                                                     m_settings.backup_compress_level(),
+                                                     m_settings.backup_compress_threads(), &stat);
+
+            if(is_snapshot)
+                QFile::remove(snapshot_file_info.filePath());
+
+            // once per chunk backup, also in release builds (as chunk recycle time)
+            if(is_compressed)
+                qInfo() << "backup: success" << in_file_info.fileName()
+                        << format_size(stat.m_in_size) << "->" << format_size(stat.m_out_size)
+                        << QString("ratio: %1").arg(stat.ratio(), 0, 'f', 2)
+                        << QString("speed: %1 MB/s").arg(stat.speed_mb(), 0, 'f', 2)
+                        << QString("time elapsed: %1 ms").arg(stat.m_elapsed);
+            else
+                qWarning() << "backup: failed" << in_file_info.fileName()
+                           << "->" << out_file_info.filePath();
+
+            if(is_compressed)
                 emit signal_state_db(file_name, state_db::file_is_backup);
-
-            //void signal_state_db(const QString &, const state_db &);
         }
     }
 }
+
+bool file_backup_workers::snapshot_db(const QString &db_name, const QString &snapshot_name)
+{
+    bool is_snapshot(false);
+
+    // VACUUM INTO fails if the target file exists
+    if(QFile::exists(snapshot_name))
+        QFile::remove(snapshot_name);
+
+    m_dbase.setDatabaseName(db_name);
+
+    if(m_dbase.open())
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        QSqlQuery query(m_dbase);
+
+        // read transaction: writer is not blocked, copy is consistent
+        is_snapshot = query.exec(vacuum_into_sql(snapshot_name));
+
+#ifdef QT_DEBUG
+        if(is_snapshot)
+            qDebug() << "Snapshot:" << snapshot_name
+                     << QString("Time elapsed: %1 ms").arg(timer.elapsed());
+        else
+            qDebug() << "Can't snapshot database:" << db_name << query.lastError().text();
+#endif
+
+        query.finish();
+        m_dbase.close();
+    }else{
+#ifdef QT_DEBUG
+        qDebug() << "Can't database open:" << db_name;
+        qDebug() << "Error:" << m_dbase.lastError();
+#endif
+    }
+
+    if((!is_snapshot)&&QFile::exists(snapshot_name))
+        QFile::remove(snapshot_name);
+
+    return is_snapshot;
+}
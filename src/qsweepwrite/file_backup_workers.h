@@ -2,6 +2,7 @@
 #define FILE_BACKUP_WORKERS_H
 
 #include <QObject>
+#include <QSqlDatabase>
 
 #include "sweep_write_settings.h"
 #include "database/db_state_workers.h"
@@ -28,6 +29,9 @@ signals:
 private:
     bool is_ready;
     sweep_write_settings m_settings;
+    QSqlDatabase m_dbase;
+
+    bool snapshot_db(const QString &, const QString &);
 };
 
 #endif // FILE_BACKUP_WORKERS_H
@@ -69,9 +69,18 @@ void mqtt_provider::stopping()
         ptr_mqtt_client->disconnectFromHost();
 }
 
-void mqtt_provider::slot_publish_message(const QByteArray &)
+void mqtt_provider::slot_publish_message(const QByteArray &message)
 {
+    if(ptr_mqtt_client)
+        if (ptr_mqtt_client->state() == QMqttClient::Connected)
+            ptr_mqtt_client->publish(ptr_sweep_topic->sweep_topic_by_type(sweep_topic::topic_db_reader), message);
+}
 
+void mqtt_provider::slot_publish_event(const QByteArray &message)
+{
+    if(ptr_mqtt_client)
+        if (ptr_mqtt_client->state() == QMqttClient::Connected)
+            ptr_mqtt_client->publish(ptr_sweep_topic->sweep_topic_by_type(sweep_topic::topic_event), message);
 }
 
 void mqtt_provider::slot_message_received(const QByteArray &message, const QMqttTopicName &topic)
@@ -98,6 +107,9 @@ void mqtt_provider::slot_message_received(const QByteArray &message, const QMqtt
                                    << broker_ctrl_data.topic_list();
 #endif
             }
+
+            if(data_received.type() == type_message::ctrl_reader)
+                emit signal_reader_ctrl(data_received.data_message());
         }
     }
 
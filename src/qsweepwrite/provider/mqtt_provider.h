@@ -27,9 +27,15 @@ signals:
     void signal_state_disconnected();
 
     void signal_received_data(const QByteArray &);
+    void signal_reader_ctrl(const QByteArray &);
 
-private slots:
+public slots:
+    // result of db reader (topic "/db/reader")
     void slot_publish_message(const QByteArray &);
+    // detected events (topic "/event")
+    void slot_publish_event(const QByteArray &);
+
+private slots:
     void slot_message_received(const QByteArray &message, const QMqttTopicName &topic = QMqttTopicName());
 
     void slot_state_connected();
@@ -1,6 +1,16 @@
 #include <QCoreApplication>
 #include "core_sweep_write.h"
 
+#ifdef Q_OS_UNIX
+#include <QSocketNotifier>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// self-pipe: the handler only writes a byte, the notifier quits in the main thread
+static int sweep_signal_fd[2] = {-1, -1};
+#endif
+
 void sweepMessageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
     QByteArray localMsg = msg.toLocal8Bit();
@@ -23,6 +33,45 @@ void sweepMessageOutput(QtMsgType type, const QMessageLogContext &context, const
     }
 }
 
+#ifdef Q_OS_UNIX
+// SIGINT/SIGTERM: async-signal-safe, workers are stopped on aboutToQuit
+void sweepSignalHandler(int)
+{
+    const char value = 1;
+    const ssize_t size = ::write(sweep_signal_fd[0], &value, sizeof(value));
+    Q_UNUSED(size);
+}
+
+void sweepSignalSetup(QCoreApplication &app)
+{
+    if(::socketpair(AF_UNIX, SOCK_STREAM, 0, sweep_signal_fd) != 0)
+    {
+        qCritical("Can't create signal socketpair.");
+        return;
+    }
+
+    auto notifier = new QSocketNotifier(sweep_signal_fd[1], QSocketNotifier::Read, &app);
+
+    QObject::connect(notifier, &QSocketNotifier::activated, &app, [notifier]() {
+        notifier->setEnabled(false);
+
+        char value;
+        const ssize_t size = ::read(sweep_signal_fd[1], &value, sizeof(value));
+        Q_UNUSED(size);
+
+        QCoreApplication::quit();
+    });
+
+    struct sigaction action;
+    action.sa_handler = sweepSignalHandler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+
+    sigaction(SIGINT, &action, Q_NULLPTR);
+    sigaction(SIGTERM, &action, Q_NULLPTR);
+}
+#endif
+
 int main(int argc, char *argv[])
 {
     QCoreApplication::setApplicationName("SweepWrite");
@@ -34,5 +83,9 @@ int main(int argc, char *argv[])
     QCoreApplication app(argc, argv);
     core_sweep_write core(app.applicationFilePath());
 
+#ifdef Q_OS_UNIX
+    sweepSignalSetup(app);
+#endif
+
     return app.exec();
 }
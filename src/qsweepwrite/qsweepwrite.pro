@@ -1,11 +1,12 @@
 QT -= gui
-QT += mqtt sql
+QT += mqtt sql concurrent
 
 CONFIG += c++11 console
 CONFIG -= app_bundle
 
 include(../../common.pri)
 include(../../protocol.pri)
+include(../../detector.pri)
 
 # The following define makes your compiler emit warnings if you use
 # any Qt feature that has been marked deprecated (the exact warnings
@@ -21,7 +22,17 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
     database/db_cleaner_workers.cpp \
     database/db_const.cpp \
+    database/db_statement.cpp \
     database/db_custom_workers.cpp \
+    database/db_bucket_workers.cpp \
+    database/db_occupancy_workers.cpp \
+    database/db_rollup_workers.cpp \
+    database/ingest_queue.cpp \
+    database/sqlite_storage.cpp \
+    database/spectr_log_reader.cpp \
+    database/spectr_log_storage.cpp \
+    database/storage_backend.cpp \
+    detector/event_detector_worker.cpp \
     file_backup_workers.cpp \
     qsweepwrite.cpp \
     core_sweep_write.cpp \
@@ -29,6 +40,7 @@ SOURCES += \
     database/db_manager.cpp \
     provider/mqtt_provider.cpp \
     database/db_reader_worker.cpp \
+    database/db_export_worker.cpp \
     database/db_writer_worker.cpp \
     database/db_state_workers.cpp
 
@@ -40,11 +52,22 @@ HEADERS += \
     core_sweep_write.h \
     database/db_cleaner_workers.h \
     database/db_custom_workers.h \
+    database/db_bucket_workers.h \
+    database/db_occupancy_workers.h \
+    database/db_rollup_workers.h \
+    database/ingest_queue.h \
+    database/sqlite_storage.h \
+    database/spectr_log_reader.h \
+    database/spectr_log_storage.h \
+    database/storage_backend.h \
+    detector/event_detector_worker.h \
     file_backup_workers.h \
     sweep_write_settings.h \
     database/db_manager.h \
     provider/mqtt_provider.h \
     database/db_const.h \
+    database/db_statement.h \
     database/db_reader_worker.h \
+    database/db_export_worker.h \
     database/db_writer_worker.h \
     database/db_state_workers.h
@@ -2,6 +2,7 @@
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
 
 static const QString HOST_BROKER_KEY = QStringLiteral("host_broker");
 static const QString PORT_BROKER_KEY = QStringLiteral("port_broker");
@@ -12,6 +13,45 @@ static const QString DB_FILE_SIZE_KEY = QStringLiteral("db_file_size");
 static const QString BACKUP_PATH_KEY = QStringLiteral("backup_path");
 static const QString DATA_BACKUP_KEY = QStringLiteral("data_backup");
 static const QString BACKUP_COMPRESS_LEVEL_KEY = QStringLiteral("backup_compress_level");
+static const QString BACKUP_COMPRESS_THREADS_KEY = QStringLiteral("backup_compress_threads");
+static const QString DB_WRITER_COUNT_KEY = QStringLiteral("db_writer_count");
+static const QString DB_WRITER_SHARDING_KEY = QStringLiteral("db_writer_sharding");
+static const QString DB_SHARD_BAND_KEY = QStringLiteral("db_shard_band");
+static const QString STORAGE_TYPE_KEY = QStringLiteral("storage_type");
+static const QString ROLLUP_KEY = QStringLiteral("rollup");
+static const QString ROLLUP_MINUTE_RETENTION_KEY = QStringLiteral("rollup_minute_retention");
+static const QString ROLLUP_HOUR_RETENTION_KEY = QStringLiteral("rollup_hour_retention");
+static const QString OCCUPANCY_KEY = QStringLiteral("occupancy");
+static const QString OCCUPANCY_WINDOW_KEY = QStringLiteral("occupancy_window");
+static const QString OCCUPANCY_THRESHOLD_KEY = QStringLiteral("occupancy_threshold");
+static const QString OCCUPANCY_RETENTION_KEY = QStringLiteral("occupancy_retention");
+static const QString EVENT_DETECTION_KEY = QStringLiteral("event_detection");
+static const QString EVENT_THRESHOLD_KEY = QStringLiteral("event_threshold");
+static const QString EVENT_MIN_BINS_KEY = QStringLiteral("event_min_bins");
+static const QString EVENT_HOLD_KEY = QStringLiteral("event_hold");
+static const QString DATA_EXPORT_KEY = QStringLiteral("data_export");
+static const QString EXPORT_PATH_KEY = QStringLiteral("export_path");
+static const QString INGEST_QUEUE_SIZE_KEY = QStringLiteral("ingest_queue_size");
+static const QString INGEST_OVERFLOW_POLICY_KEY = QStringLiteral("ingest_overflow_policy");
+
+static const QMap<shard_policy, QString> shard_policy_name
+{
+    {shard_policy::params_id, "params_id"},
+    {shard_policy::band, "band"}
+};
+
+static const QMap<storage_type, QString> storage_type_name
+{
+    {storage_type::sqlite, "sqlite"},
+    {storage_type::spectr_log, "spectr_log"}
+};
+
+static const QMap<overflow_policy, QString> overflow_policy_name
+{
+    {overflow_policy::block, "block"},
+    {overflow_policy::drop_oldest, "drop_oldest"},
+    {overflow_policy::spill, "spill"}
+};
 
 class sweep_write_settings_data : public QSharedData {
 public:
@@ -27,6 +67,26 @@ public:
         m_backup_path = "";
         m_data_backup = false;
         m_compress_level = -1;
+        m_compress_threads = 1;
+        m_db_writer_count = 1;
+        m_db_writer_sharding = shard_policy::params_id;
+        m_db_shard_band = 1000;
+        m_storage_type = storage_type::sqlite;
+        m_rollup = false;
+        m_rollup_minute_retention = 48;
+        m_rollup_hour_retention = 720;
+        m_occupancy = false;
+        m_occupancy_window = 900;
+        m_occupancy_threshold = -80;
+        m_occupancy_retention = 720;
+        m_event_detection = false;
+        m_event_threshold = 10;
+        m_event_min_bins = 2;
+        m_event_hold = 3;
+        m_data_export = false;
+        m_export_path = "";
+        m_ingest_queue_size = 1000;
+        m_ingest_overflow_policy = overflow_policy::drop_oldest;
     }
     sweep_write_settings_data(const sweep_write_settings_data &other) : QSharedData(other)
     {
@@ -40,6 +100,26 @@ public:
         m_backup_path = other.m_backup_path;
         m_data_backup = other.m_data_backup;
         m_compress_level = other.m_compress_level;
+        m_compress_threads = other.m_compress_threads;
+        m_db_writer_count = other.m_db_writer_count;
+        m_db_writer_sharding = other.m_db_writer_sharding;
+        m_db_shard_band = other.m_db_shard_band;
+        m_storage_type = other.m_storage_type;
+        m_rollup = other.m_rollup;
+        m_rollup_minute_retention = other.m_rollup_minute_retention;
+        m_rollup_hour_retention = other.m_rollup_hour_retention;
+        m_occupancy = other.m_occupancy;
+        m_occupancy_window = other.m_occupancy_window;
+        m_occupancy_threshold = other.m_occupancy_threshold;
+        m_occupancy_retention = other.m_occupancy_retention;
+        m_event_detection = other.m_event_detection;
+        m_event_threshold = other.m_event_threshold;
+        m_event_min_bins = other.m_event_min_bins;
+        m_event_hold = other.m_event_hold;
+        m_data_export = other.m_data_export;
+        m_export_path = other.m_export_path;
+        m_ingest_queue_size = other.m_ingest_queue_size;
+        m_ingest_overflow_policy = other.m_ingest_overflow_policy;
     }
 
     ~sweep_write_settings_data() {}
@@ -54,10 +134,35 @@ public:
     // database chunk count
     qint32 m_db_file_count;
     qint32 m_db_file_size;
+    // db writers (threads)
+    qint32 m_db_writer_count;
+    shard_policy m_db_writer_sharding;
+    qint32 m_db_shard_band;     // MHz
+    storage_type m_storage_type;
     // backup path
     QString m_backup_path;
     bool m_data_backup;
     int m_compress_level;
+    int m_compress_threads;
+    // rollup tiers, retention (hours)
+    bool m_rollup;
+    qint32 m_rollup_minute_retention;
+    qint32 m_rollup_hour_retention;
+    // occupancy statistics, window (s), threshold (dBm), retention (hours)
+    bool m_occupancy;
+    qint32 m_occupancy_window;
+    qreal m_occupancy_threshold;
+    qint32 m_occupancy_retention;
+    // event detection: threshold above noise floor (dB), width (bins), hold (sweeps)
+    bool m_event_detection;
+    qreal m_event_threshold;
+    qint32 m_event_min_bins;
+    qint32 m_event_hold;
+    bool m_data_export;
+    QString m_export_path;
+    // ingest queue (messages)
+    int m_ingest_queue_size;
+    overflow_policy m_ingest_overflow_policy;
 };
 
 sweep_write_settings::sweep_write_settings() : data(new sweep_write_settings_data)
@@ -81,9 +186,32 @@ sweep_write_settings::sweep_write_settings(const QByteArray &json) : data(new sw
     data->m_db_path = json_object.value(DB_PATH_KEY).toString();
     data->m_db_file_count = json_object.value(DB_FILE_COUNT_KEY).toInt(1);
     data->m_db_file_size = json_object.value(DB_FILE_SIZE_KEY).toInt(100);
+    data->m_db_writer_count = json_object.value(DB_WRITER_COUNT_KEY).toInt(1);
+    data->m_db_writer_sharding = shard_policy_name.key(json_object.value(DB_WRITER_SHARDING_KEY).toString(),
+                                                       shard_policy::params_id);
+    data->m_db_shard_band = json_object.value(DB_SHARD_BAND_KEY).toInt(1000);
+    data->m_storage_type = storage_type_name.key(json_object.value(STORAGE_TYPE_KEY).toString(),
+                                                 storage_type::sqlite);
     data->m_backup_path = json_object.value(BACKUP_PATH_KEY).toString();
     data->m_data_backup = json_object.value(DATA_BACKUP_KEY).toBool();
     data->m_compress_level = json_object.value(BACKUP_COMPRESS_LEVEL_KEY).toInt(-1);
+    data->m_compress_threads = json_object.value(BACKUP_COMPRESS_THREADS_KEY).toInt(1);
+    data->m_rollup = json_object.value(ROLLUP_KEY).toBool(false);
+    data->m_rollup_minute_retention = json_object.value(ROLLUP_MINUTE_RETENTION_KEY).toInt(48);
+    data->m_rollup_hour_retention = json_object.value(ROLLUP_HOUR_RETENTION_KEY).toInt(720);
+    data->m_occupancy = json_object.value(OCCUPANCY_KEY).toBool(false);
+    data->m_occupancy_window = json_object.value(OCCUPANCY_WINDOW_KEY).toInt(900);
+    data->m_occupancy_threshold = json_object.value(OCCUPANCY_THRESHOLD_KEY).toDouble(-80);
+    data->m_occupancy_retention = json_object.value(OCCUPANCY_RETENTION_KEY).toInt(720);
+    data->m_event_detection = json_object.value(EVENT_DETECTION_KEY).toBool(false);
+    data->m_event_threshold = json_object.value(EVENT_THRESHOLD_KEY).toDouble(10);
+    data->m_event_min_bins = json_object.value(EVENT_MIN_BINS_KEY).toInt(2);
+    data->m_event_hold = json_object.value(EVENT_HOLD_KEY).toInt(3);
+    data->m_data_export = json_object.value(DATA_EXPORT_KEY).toBool(false);
+    data->m_export_path = json_object.value(EXPORT_PATH_KEY).toString();
+    data->m_ingest_queue_size = json_object.value(INGEST_QUEUE_SIZE_KEY).toInt(1000);
+    data->m_ingest_overflow_policy = overflow_policy_name.key(json_object.value(INGEST_OVERFLOW_POLICY_KEY).toString(),
+                                                              overflow_policy::drop_oldest);
 
     if(!doc.isEmpty())
         data->m_valid = true;
@@ -198,6 +326,206 @@ int sweep_write_settings::backup_compress_level() const
     return data->m_compress_level;
 }
 
+void sweep_write_settings::set_backup_compress_threads(const int &value)
+{
+    data->m_compress_threads = value;
+}
+
+int sweep_write_settings::backup_compress_threads() const
+{
+    return data->m_compress_threads;
+}
+
+void sweep_write_settings::set_db_writer_count(const qint32 &value)
+{
+    data->m_db_writer_count = value;
+}
+
+qint32 sweep_write_settings::db_writer_count() const
+{
+    return data->m_db_writer_count;
+}
+
+void sweep_write_settings::set_db_writer_sharding(const shard_policy &value)
+{
+    data->m_db_writer_sharding = value;
+}
+
+shard_policy sweep_write_settings::db_writer_sharding() const
+{
+    return data->m_db_writer_sharding;
+}
+
+void sweep_write_settings::set_db_shard_band(const qint32 &value)
+{
+    data->m_db_shard_band = value;
+}
+
+qint32 sweep_write_settings::db_shard_band() const
+{
+    return data->m_db_shard_band;
+}
+
+void sweep_write_settings::set_storage(const storage_type &value)
+{
+    data->m_storage_type = value;
+}
+
+storage_type sweep_write_settings::storage() const
+{
+    return data->m_storage_type;
+}
+
+void sweep_write_settings::set_rollup(const bool &value)
+{
+    data->m_rollup = value;
+}
+
+bool sweep_write_settings::rollup() const
+{
+    return data->m_rollup;
+}
+
+void sweep_write_settings::set_rollup_minute_retention(const qint32 &value)
+{
+    data->m_rollup_minute_retention = value;
+}
+
+qint32 sweep_write_settings::rollup_minute_retention() const
+{
+    return data->m_rollup_minute_retention;
+}
+
+void sweep_write_settings::set_rollup_hour_retention(const qint32 &value)
+{
+    data->m_rollup_hour_retention = value;
+}
+
+qint32 sweep_write_settings::rollup_hour_retention() const
+{
+    return data->m_rollup_hour_retention;
+}
+
+void sweep_write_settings::set_occupancy(const bool &value)
+{
+    data->m_occupancy = value;
+}
+
+bool sweep_write_settings::occupancy() const
+{
+    return data->m_occupancy;
+}
+
+void sweep_write_settings::set_occupancy_window(const qint32 &value)
+{
+    data->m_occupancy_window = value;
+}
+
+qint32 sweep_write_settings::occupancy_window() const
+{
+    return data->m_occupancy_window;
+}
+
+void sweep_write_settings::set_occupancy_threshold(const qreal &value)
+{
+    data->m_occupancy_threshold = value;
+}
+
+qreal sweep_write_settings::occupancy_threshold() const
+{
+    return data->m_occupancy_threshold;
+}
+
+void sweep_write_settings::set_occupancy_retention(const qint32 &value)
+{
+    data->m_occupancy_retention = value;
+}
+
+qint32 sweep_write_settings::occupancy_retention() const
+{
+    return data->m_occupancy_retention;
+}
+
+void sweep_write_settings::set_event_detection(const bool &value)
+{
+    data->m_event_detection = value;
+}
+
+bool sweep_write_settings::event_detection() const
+{
+    return data->m_event_detection;
+}
+
+void sweep_write_settings::set_event_threshold(const qreal &value)
+{
+    data->m_event_threshold = value;
+}
+
+qreal sweep_write_settings::event_threshold() const
+{
+    return data->m_event_threshold;
+}
+
+void sweep_write_settings::set_event_min_bins(const qint32 &value)
+{
+    data->m_event_min_bins = value;
+}
+
+qint32 sweep_write_settings::event_min_bins() const
+{
+    return data->m_event_min_bins;
+}
+
+void sweep_write_settings::set_event_hold(const qint32 &value)
+{
+    data->m_event_hold = value;
+}
+
+qint32 sweep_write_settings::event_hold() const
+{
+    return data->m_event_hold;
+}
+
+void sweep_write_settings::set_data_export(const bool &value)
+{
+    data->m_data_export = value;
+}
+
+bool sweep_write_settings::data_export() const
+{
+    return data->m_data_export;
+}
+
+void sweep_write_settings::set_export_path(const QString &value)
+{
+    data->m_export_path = value;
+}
+
+QString sweep_write_settings::export_path() const
+{
+    return data->m_export_path;
+}
+
+void sweep_write_settings::set_ingest_queue_size(const int &value)
+{
+    data->m_ingest_queue_size = value;
+}
+
+int sweep_write_settings::ingest_queue_size() const
+{
+    return data->m_ingest_queue_size;
+}
+
+void sweep_write_settings::set_ingest_overflow_policy(const overflow_policy &value)
+{
+    data->m_ingest_overflow_policy = value;
+}
+
+overflow_policy sweep_write_settings::ingest_overflow_policy() const
+{
+    return data->m_ingest_overflow_policy;
+}
+
 QByteArray sweep_write_settings::to_json() const
 {
     QJsonObject json_object;
@@ -207,9 +535,29 @@ QByteArray sweep_write_settings::to_json() const
     json_object.insert(DB_PATH_KEY, data->m_db_path);
     json_object.insert(DB_FILE_COUNT_KEY, data->m_db_file_count);
     json_object.insert(DB_FILE_SIZE_KEY, data->m_db_file_size);
+    json_object.insert(DB_WRITER_COUNT_KEY, data->m_db_writer_count);
+    json_object.insert(DB_WRITER_SHARDING_KEY, shard_policy_name.value(data->m_db_writer_sharding));
+    json_object.insert(DB_SHARD_BAND_KEY, data->m_db_shard_band);
+    json_object.insert(STORAGE_TYPE_KEY, storage_type_name.value(data->m_storage_type));
     json_object.insert(BACKUP_PATH_KEY, data->m_backup_path);
     json_object.insert(DATA_BACKUP_KEY, data->m_data_backup);
     json_object.insert(BACKUP_COMPRESS_LEVEL_KEY, data->m_compress_level);
+    json_object.insert(BACKUP_COMPRESS_THREADS_KEY, data->m_compress_threads);
+    json_object.insert(ROLLUP_KEY, data->m_rollup);
+    json_object.insert(ROLLUP_MINUTE_RETENTION_KEY, data->m_rollup_minute_retention);
+    json_object.insert(ROLLUP_HOUR_RETENTION_KEY, data->m_rollup_hour_retention);
+    json_object.insert(OCCUPANCY_KEY, data->m_occupancy);
+    json_object.insert(OCCUPANCY_WINDOW_KEY, data->m_occupancy_window);
+    json_object.insert(OCCUPANCY_THRESHOLD_KEY, data->m_occupancy_threshold);
+    json_object.insert(OCCUPANCY_RETENTION_KEY, data->m_occupancy_retention);
+    json_object.insert(EVENT_DETECTION_KEY, data->m_event_detection);
+    json_object.insert(EVENT_THRESHOLD_KEY, data->m_event_threshold);
+    json_object.insert(EVENT_MIN_BINS_KEY, data->m_event_min_bins);
+    json_object.insert(EVENT_HOLD_KEY, data->m_event_hold);
+    json_object.insert(DATA_EXPORT_KEY, data->m_data_export);
+    json_object.insert(EXPORT_PATH_KEY, data->m_export_path);
+    json_object.insert(INGEST_QUEUE_SIZE_KEY, data->m_ingest_queue_size);
+    json_object.insert(INGEST_OVERFLOW_POLICY_KEY, overflow_policy_name.value(data->m_ingest_overflow_policy));
 
     QJsonDocument doc(json_object);
 
@@ -4,6 +4,25 @@
 #include <QtCore/qshareddata.h>
 #include <QtCore/qmetatype.h>
 
+// ingest queue overflow
+enum class overflow_policy: qint32 {
+    block = 0,
+    drop_oldest,
+    spill
+};
+
+// chunk storage
+enum class storage_type: qint32 {
+    sqlite = 0,
+    spectr_log
+};
+
+// sweep routing between db writers
+enum class shard_policy: qint32 {
+    params_id = 0,
+    band
+};
+
 class sweep_write_settings_data;
 
 class sweep_write_settings
@@ -44,6 +63,67 @@ public:
     void set_backup_compress_level(const int &);
     int backup_compress_level()const;
 
+    void set_backup_compress_threads(const int &);
+    int backup_compress_threads()const;
+
+    void set_db_writer_count(const qint32 &);
+    qint32 db_writer_count()const;
+
+    void set_db_writer_sharding(const shard_policy &);
+    shard_policy db_writer_sharding()const;
+
+    void set_db_shard_band(const qint32 &);
+    qint32 db_shard_band()const;
+
+    void set_storage(const storage_type &);
+    storage_type storage()const;
+
+    void set_rollup(const bool &);
+    bool rollup()const;
+
+    void set_rollup_minute_retention(const qint32 &);
+    qint32 rollup_minute_retention()const;
+
+    void set_rollup_hour_retention(const qint32 &);
+    qint32 rollup_hour_retention()const;
+
+    void set_occupancy(const bool &);
+    bool occupancy()const;
+
+    void set_occupancy_window(const qint32 &);
+    qint32 occupancy_window()const;
+
+    void set_occupancy_threshold(const qreal &);
+    qreal occupancy_threshold()const;
+
+    void set_occupancy_retention(const qint32 &);
+    qint32 occupancy_retention()const;
+
+    void set_event_detection(const bool &);
+    bool event_detection()const;
+
+    void set_event_threshold(const qreal &);
+    qreal event_threshold()const;
+
+    void set_event_min_bins(const qint32 &);
+    qint32 event_min_bins()const;
+
+    void set_event_hold(const qint32 &);
+    qint32 event_hold()const;
+
+    void set_data_export(const bool &);
+    bool data_export()const;
+
+    // export files (db_path if empty)
+    void set_export_path(const QString &);
+    QString export_path()const;
+
+    void set_ingest_queue_size(const int &);
+    int ingest_queue_size()const;
+
+    void set_ingest_overflow_policy(const overflow_policy &);
+    overflow_policy ingest_overflow_policy()const;
+
     QByteArray to_json() const;
 
 private: